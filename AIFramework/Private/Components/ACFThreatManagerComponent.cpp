@@ -1,10 +1,16 @@
 // Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
 
 #include "Components/ACFThreatManagerComponent.h"
+#include "ACFAIStats.h"
 #include "Actors/ACFActor.h"
 #include "Actors/ACFCharacter.h"
 #include "Interfaces/ACFEntityInterface.h"
+#include <Engine/World.h>
 #include <GameFramework/Actor.h>
+#include <TimerManager.h>
+
+DECLARE_CYCLE_STAT(TEXT("Threat Decay"), STAT_ACFThreatDecay, STATGROUP_ACFAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Threat Updates"), STAT_ACFThreatUpdates, STATGROUP_ACFAI);
 
 // Sets default values for this component's properties
 UACFThreatManagerComponent::UACFThreatManagerComponent()
@@ -46,10 +52,10 @@ void UACFThreatManagerComponent::AddThreat(AActor* threatening, float threat)
     }
 
     if (IACFEntityInterface::Execute_IsEntityAlive(threatening)) {
-        if (ThreatMap.Contains(threatening)) {
-            threat += ThreatMap.FindAndRemoveChecked(threatening) * GetThreatMultForActor(threatening);
+        if (const int32* index = threatIndices.Find(threatening)) {
+            threat += threatHeap[*index].Threat * GetThreatMultForActor(threatening);
         }
-        const float threatMult = ThreatMap.Add(threatening, threat);
+        SetThreat(threatening, threat);
         UpdateMaxThreat();
     } else {
         RemoveThreatening(threatening);
@@ -68,12 +74,14 @@ void UACFThreatManagerComponent::RemoveThreat(class AActor* threatening, float t
     }
 
     if (IACFEntityInterface::Execute_IsEntityAlive(threatening)) {
-        if (ThreatMap.Contains(threatening)) {
-            threat -= ThreatMap.FindAndRemoveChecked(threatening);
+        if (const int32* index = threatIndices.Find(threatening)) {
+            threat -= threatHeap[*index].Threat;
 
             if (threat >= 0) {
-                ThreatMap.Add(threatening, threat);
+                SetThreat(threatening, threat);
                 UpdateMaxThreat();
+            } else {
+                RemoveThreatening(threatening);
             }
         }
     } else {
@@ -83,26 +91,24 @@ void UACFThreatManagerComponent::RemoveThreat(class AActor* threatening, float t
 
 class AActor* UACFThreatManagerComponent::GetActorWithHigherThreat()
 {
-    float maxThreat = -1.f;
-    AActor* target = nullptr;
-    TArray<AActor*> pendingDelete;
-
-    for (const auto& elem : ThreatMap) {
-        IACFEntityInterface* entity = Cast<IACFEntityInterface>(elem.Key);
-
-        if (!entity || !elem.Key || !IACFEntityInterface::Execute_IsEntityAlive(elem.Key)) {
-            pendingDelete.Add(elem.Key);
-        } else if (elem.Value > maxThreat) {
-            maxThreat = elem.Value;
-            target = elem.Key;
+    // Characters leave the table when they die, the other entities are only checked once they are the top threat
+    while (threatHeap.Num() > 0) {
+        AActor* top = threatHeap[0].Threatening;
+        if (top && (!threatHeap[0].bPollAlive || IACFEntityInterface::Execute_IsEntityAlive(top))) {
+            return top;
+        }
+        RemoveThreatAt(0);
+        if (maxThreatening == top) {
+            maxThreatening = nullptr;
         }
     }
+    return nullptr;
+}
 
-    for (auto* toDelete : pendingDelete) {
-        RemoveThreatening(toDelete);
-    }
-
-    return target;
+float UACFThreatManagerComponent::GetThreatForActor(const AActor* threatening) const
+{
+    const int32* index = threatIndices.Find(threatening);
+    return index ? threatHeap[*index].Threat : 0.f;
 }
 
 bool UACFThreatManagerComponent::IsActorAPotentialThreat(class AActor* threatening) const
@@ -131,7 +137,7 @@ bool UACFThreatManagerComponent::IsActorAPotentialThreat(class AActor* threateni
 
 bool UACFThreatManagerComponent::IsThreatening(class AActor* threatening) const
 {
-    return ThreatMap.Contains(threatening);
+    return threatIndices.Contains(threatening);
 }
 
 float UACFThreatManagerComponent::GetThreatMultForActor(class AActor* threatening) const
@@ -171,8 +177,8 @@ float UACFThreatManagerComponent::GetDefaultThreatForActor(AActor* threatening)
 
 void UACFThreatManagerComponent::RemoveThreatening(AActor* threatening)
 {
-    if (ThreatMap.Contains(threatening)) {
-        ThreatMap.FindAndRemoveChecked(threatening);
+    if (const int32* index = threatIndices.Find(threatening)) {
+        RemoveThreatAt(*index);
     }
 
     if (maxThreatening == threatening) {
@@ -183,6 +189,160 @@ void UACFThreatManagerComponent::RemoveThreatening(AActor* threatening)
 
 void UACFThreatManagerComponent::RemoveAllThreatenings()
 {
-    ThreatMap.Empty();
+    for (const FACFThreatEntry& entry : threatHeap) {
+        UnbindThreatening(entry.Threatening);
+    }
+    threatHeap.Empty();
+    threatIndices.Empty();
+    maxThreatening = nullptr;
+    if (UWorld* world = GetWorld()) {
+        world->GetTimerManager().ClearTimer(decayTimer);
+    }
     OnNewMaxThreateningActor.Broadcast(nullptr);
 }
+
+void UACFThreatManagerComponent::SetThreat(AActor* threatening, float threat)
+{
+    INC_DWORD_STAT(STAT_ACFThreatUpdates);
+
+    if (const int32* index = threatIndices.Find(threatening)) {
+        const int32 entry = *index;
+        const float oldThreat = threatHeap[entry].Threat;
+        threatHeap[entry].Threat = threat;
+        if (threat > oldThreat) {
+            SiftUp(entry);
+        } else {
+            SiftDown(entry);
+        }
+        return;
+    }
+
+    FACFThreatEntry newEntry;
+    newEntry.Threatening = threatening;
+    newEntry.Threat = threat;
+    newEntry.Key = threatening;
+    newEntry.bPollAlive = !threatening->IsA<AACFCharacter>();
+    const int32 index = threatHeap.Add(newEntry);
+    threatIndices.Add(threatening, index);
+    BindThreatening(threatening);
+    SiftUp(index);
+
+    if (ThreatDecayPerSecond > 0.f && !decayTimer.IsValid()) {
+        if (UWorld* world = GetWorld()) {
+            world->GetTimerManager().SetTimer(decayTimer, this, &UACFThreatManagerComponent::ApplyThreatDecay, ThreatDecayInterval, true);
+        }
+    }
+}
+
+void UACFThreatManagerComponent::RemoveThreatAt(int32 index)
+{
+    UnbindThreatening(threatHeap[index].Threatening);
+
+    const TObjectKey<AActor> key = threatHeap[index].Key;
+    const int32 last = threatHeap.Num() - 1;
+    if (index != last) {
+        SwapEntries(index, last);
+    }
+    threatHeap.Pop();
+    threatIndices.Remove(key);
+
+    if (index < threatHeap.Num()) {
+        SiftDown(index);
+        SiftUp(index);
+    }
+}
+
+void UACFThreatManagerComponent::SiftUp(int32 index)
+{
+    while (index > 0) {
+        const int32 parent = (index - 1) / 2;
+        if (threatHeap[index].Threat <= threatHeap[parent].Threat) {
+            return;
+        }
+        SwapEntries(index, parent);
+        index = parent;
+    }
+}
+
+void UACFThreatManagerComponent::SiftDown(int32 index)
+{
+    const int32 num = threatHeap.Num();
+    while (true) {
+        const int32 left = index * 2 + 1;
+        const int32 right = left + 1;
+        int32 largest = index;
+        if (left < num && threatHeap[left].Threat > threatHeap[largest].Threat) {
+            largest = left;
+        }
+        if (right < num && threatHeap[right].Threat > threatHeap[largest].Threat) {
+            largest = right;
+        }
+        if (largest == index) {
+            return;
+        }
+        SwapEntries(index, largest);
+        index = largest;
+    }
+}
+
+void UACFThreatManagerComponent::SwapEntries(int32 first, int32 second)
+{
+    threatHeap.Swap(first, second);
+    threatIndices.Add(threatHeap[first].Key, first);
+    threatIndices.Add(threatHeap[second].Key, second);
+}
+
+void UACFThreatManagerComponent::BindThreatening(AActor* threatening)
+{
+    threatening->OnEndPlay.AddUniqueDynamic(this, &UACFThreatManagerComponent::HandleThreateningEndPlay);
+    if (AACFCharacter* character = Cast<AACFCharacter>(threatening)) {
+        character->OnDeath.AddUniqueDynamic(this, &UACFThreatManagerComponent::HandleThreateningDeath);
+    }
+}
+
+void UACFThreatManagerComponent::UnbindThreatening(AActor* threatening)
+{
+    if (!threatening) {
+        return;
+    }
+    threatening->OnEndPlay.RemoveDynamic(this, &UACFThreatManagerComponent::HandleThreateningEndPlay);
+    if (AACFCharacter* character = Cast<AACFCharacter>(threatening)) {
+        character->OnDeath.RemoveDynamic(this, &UACFThreatManagerComponent::HandleThreateningDeath);
+    }
+}
+
+void UACFThreatManagerComponent::ApplyThreatDecay()
+{
+    SCOPE_CYCLE_COUNTER(STAT_ACFThreatDecay);
+
+    // The same amount comes off every entry, so the heap order holds without sifting anything
+    const float decay = ThreatDecayPerSecond * ThreatDecayInterval;
+    TArray<AActor*> expired;
+    for (FACFThreatEntry& entry : threatHeap) {
+        entry.Threat -= decay;
+        if (entry.Threat <= 0.f) {
+            expired.Add(entry.Threatening);
+        }
+    }
+
+    for (AActor* threatening : expired) {
+        RemoveThreatening(threatening);
+    }
+
+    if (threatHeap.Num() == 0) {
+        if (UWorld* world = GetWorld()) {
+            world->GetTimerManager().ClearTimer(decayTimer);
+        }
+    }
+    UpdateMaxThreat();
+}
+
+void UACFThreatManagerComponent::HandleThreateningDeath(AACFCharacter* character)
+{
+    RemoveThreatening(character);
+}
+
+void UACFThreatManagerComponent::HandleThreateningEndPlay(AActor* actor, EEndPlayReason::Type endPlayReason)
+{
+    RemoveThreatening(actor);
+}
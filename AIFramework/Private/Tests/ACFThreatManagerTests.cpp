@@ -0,0 +1,107 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "Actors/ACFActor.h"
+#include "Components/ACFThreatManagerComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FACFThreatManagerChurnTest, "AIFramework.ThreatManager.Churn",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FACFThreatManagerChurnTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 numActors = 40;
+    constexpr int32 numOperations = 20000;
+    constexpr int32 decayEvery = 200;
+
+    UWorld* world = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    worldContext.SetCurrentWorld(world);
+
+    AActor* owner = world->SpawnActor<AActor>();
+    UACFThreatManagerComponent* threatManager = NewObject<UACFThreatManagerComponent>(owner);
+    threatManager->ThreatDecayPerSecond = 5.f;
+    threatManager->ThreatDecayInterval = 1.f;
+
+    TArray<AActor*> threatenings;
+    for (int32 index = 0; index < numActors; index++) {
+        threatenings.Add(world->SpawnActor<AACFActor>());
+    }
+
+    // Max-heap order, and every entry at the index threatIndices has for it
+    auto checkConsistency = [this, threatManager](const TCHAR* step) {
+        const TArray<FACFThreatEntry>& heap = threatManager->threatHeap;
+        bool bConsistent = threatManager->threatIndices.Num() == heap.Num();
+        for (int32 index = 0; bConsistent && index < heap.Num(); index++) {
+            const int32* storedIndex = threatManager->threatIndices.Find(heap[index].Key);
+            bConsistent = storedIndex && *storedIndex == index && (index == 0 || heap[(index - 1) / 2].Threat >= heap[index].Threat);
+        }
+        if (!bConsistent) {
+            AddError(FString::Printf(TEXT("Threat heap is inconsistent after %s"), step));
+        }
+        return bConsistent;
+    };
+
+    FRandomStream stream(numActors);
+    bool bConsistent = true;
+    const double startTime = FPlatformTime::Seconds();
+    for (int32 operation = 0; bConsistent && operation < numOperations; operation++) {
+        AActor* threatening = threatenings[stream.RandHelper(numActors)];
+        const int32 roll = stream.RandHelper(10);
+        const TCHAR* step = TEXT("AddThreat");
+        if (roll < 6) {
+            threatManager->AddThreat(threatening, stream.FRandRange(1.f, 50.f));
+        } else if (roll < 8) {
+            step = TEXT("RemoveThreat");
+            threatManager->RemoveThreat(threatening, stream.FRandRange(1.f, 50.f));
+        } else if (roll < 9) {
+            step = TEXT("RemoveThreatening");
+            threatManager->RemoveThreatening(threatening);
+        } else {
+            // Anywhere in the heap, not only the top, as when an actor dies or ends play
+            step = TEXT("RemoveThreatAt");
+            if (threatManager->threatHeap.Num() > 0) {
+                threatManager->RemoveThreatAt(stream.RandHelper(threatManager->threatHeap.Num()));
+            }
+        }
+        bConsistent = checkConsistency(step);
+
+        if (bConsistent && operation % decayEvery == decayEvery - 1) {
+            threatManager->ApplyThreatDecay();
+            bConsistent = checkConsistency(TEXT("ApplyThreatDecay"));
+            for (const FACFThreatEntry& entry : threatManager->threatHeap) {
+                if (entry.Threat <= 0.f) {
+                    AddError(TEXT("ApplyThreatDecay left an expired threat in the heap"));
+                    bConsistent = false;
+                    break;
+                }
+            }
+        }
+
+        if (bConsistent) {
+            float maxThreat = 0.f;
+            for (const FACFThreatEntry& entry : threatManager->threatHeap) {
+                maxThreat = FMath::Max(maxThreat, entry.Threat);
+            }
+            AActor* top = threatManager->GetActorWithHigherThreat();
+            bConsistent = TestTrue(TEXT("The top of the heap is the highest threat"),
+                threatManager->threatHeap.Num() == 0 ? top == nullptr : threatManager->GetThreatForActor(top) == maxThreat);
+        }
+    }
+    const double churnMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+    AddInfo(FString::Printf(TEXT("%d operations over %d actors in %.2f ms"), numOperations, numActors, churnMs));
+
+    threatManager->RemoveAllThreatenings();
+    checkConsistency(TEXT("RemoveAllThreatenings"));
+
+    GEngine->DestroyWorldContext(world);
+    world->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -4,12 +4,38 @@
 
 #include "Components/ActorComponent.h"
 #include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
 
 #include "ACFThreatManagerComponent.generated.h"
 
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNewMaxThreateningActor, class AActor*, threatening);
 
+USTRUCT()
+struct FACFThreatEntry {
+    GENERATED_BODY()
+
+public:
+    FACFThreatEntry()
+    {
+        Threatening = nullptr;
+        Threat = 0.f;
+        bPollAlive = false;
+    }
+
+    UPROPERTY()
+    class AActor* Threatening;
+
+    UPROPERTY()
+    float Threat;
+
+    // Still valid once the actor is gone, to drop it from the heap indices
+    TObjectKey<AActor> Key;
+
+    // Entities without a death event are checked when they reach the top of the heap
+    bool bPollAlive;
+};
+
 UCLASS(ClassGroup = (ACF), Blueprintable, meta = (BlueprintSpawnableComponent))
 class AIFRAMEWORK_API UACFThreatManagerComponent : public UActorComponent {
     GENERATED_BODY()
@@ -26,10 +52,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = ACF)
     void RemoveThreat(class AActor* threatening, float threat);
 
-    /*Returns the actor with higher threat*/
+    /*Returns the actor with higher threat, without going through the whole table*/
     UFUNCTION(BlueprintPure, Category = ACF)
     class AActor* GetActorWithHigherThreat();
 
+    /*Returns the current threat of the actor, 0 if it is not in the threat table*/
+    UFUNCTION(BlueprintPure, Category = ACF)
+    float GetThreatForActor(const AActor* threatening) const;
+
     /*Returns true if this actor is a potential enemy*/
     UFUNCTION(BlueprintCallable, Category = ACF)
     bool IsActorAPotentialThreat(class AActor* threatening) const;
@@ -67,12 +97,53 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ACF)
     TMap<TSubclassOf<AActor>, float> ThreatMultipliersByActor;
 
+    /*Threat removed every second from all the threatening actors, the ones that reach 0 are removed. 0 disables the decay*/
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 0), Category = ACF)
+    float ThreatDecayPerSecond = 0.f;
+
+    /*Seconds between two decay passes, all the threats decay together in each pass*/
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 0.1), Category = ACF)
+    float ThreatDecayInterval = 1.f;
+
 private:
+    // Max-heap on Threat, the most threatening actor is always the first entry
     UPROPERTY()
-    TMap<class AActor*, float> ThreatMap;
+    TArray<FACFThreatEntry> threatHeap;
+
+    TMap<TObjectKey<AActor>, int32> threatIndices;
 
     UPROPERTY()
     class AActor* maxThreatening;
 
+    FTimerHandle decayTimer;
+
     void UpdateMaxThreat();
+
+    /*Inserts the actor or moves it to the position of its new threat*/
+    void SetThreat(AActor* threatening, float threat);
+
+    void RemoveThreatAt(int32 index);
+
+    void SiftUp(int32 index);
+
+    void SiftDown(int32 index);
+
+    void SwapEntries(int32 first, int32 second);
+
+    void BindThreatening(AActor* threatening);
+
+    void UnbindThreatening(AActor* threatening);
+
+    void ApplyThreatDecay();
+
+    UFUNCTION()
+    void HandleThreateningDeath(class AACFCharacter* character);
+
+    UFUNCTION()
+    void HandleThreateningEndPlay(AActor* actor, EEndPlayReason::Type endPlayReason);
+
+#if WITH_DEV_AUTOMATION_TESTS
+    // Checks the heap and its indices after each operation
+    friend class FACFThreatManagerChurnTest;
+#endif
 };
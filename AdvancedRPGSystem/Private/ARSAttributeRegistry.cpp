@@ -0,0 +1,80 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ARSAttributeRegistry.h"
+#include "ARSDeveloperSettings.h"
+#include "ARSFunctionLibrary.h"
+#include <GameplayTagsManager.h>
+#include <GameplayTagsModule.h>
+
+FARSAttributeRegistry& FARSAttributeRegistry::Get()
+{
+    checkSlow(IsInGameThread());
+
+    static FARSAttributeRegistry registry;
+    if (!registry.bListening) {
+        registry.bListening = true;
+
+        // Tags can be added after the first use, i.e. native tags of modules loaded later or new tags in the editor
+        IGameplayTagsModule::OnGameplayTagTreeChanged.AddLambda([]() {
+            registry.bDirty = true;
+        });
+#if WITH_EDITOR
+        UGameplayTagsManager::OnEditorRefreshGameplayTagTree.AddLambda([]() {
+            registry.bDirty = true;
+        });
+        // The tag roots are only edited in the editor settings
+        GetMutableDefault<UARSDeveloperSettings>()->OnSettingChanged().AddLambda([](UObject*, FPropertyChangedEvent&) {
+            registry.bDirty = true;
+        });
+#endif
+    }
+
+    if (registry.bDirty) {
+        registry.Rebuild();
+    }
+    return registry;
+}
+
+void FARSAttributeRegistry::Rebuild()
+{
+    // Indices are never reused, tags that are no longer under a root only stop resolving
+    for (TPair<FGameplayTag, FRegisteredTag>& entry : tagIndices) {
+        entry.Value.bActive = false;
+    }
+
+    RegisterChildren(UARSFunctionLibrary::GetAttributesTagRoot(), EStatisticsType::EPrimaryAttribute);
+    RegisterChildren(UARSFunctionLibrary::GetParametersTagRoot(), EStatisticsType::ESecondaryAttribute);
+    RegisterChildren(UARSFunctionLibrary::GetStatisticsTagRoot(), EStatisticsType::EStatistic);
+
+    bDirty = false;
+}
+
+void FARSAttributeRegistry::RegisterChildren(const FGameplayTag& root, EStatisticsType type)
+{
+    if (!root.IsValid()) {
+        UE_LOG(LogTemp, Warning, TEXT("Missing Tag Root! - ARSAttributeRegistry"));
+        return;
+    }
+
+    const FGameplayTagContainer children = UGameplayTagsManager::Get().RequestGameplayTagChildren(root);
+    for (const FGameplayTag& tag : children) {
+        FRegisteredTag* registered = tagIndices.Find(tag);
+        if (registered) {
+            // Under another root already in this pass
+            if (registered->bActive) {
+                continue;
+            }
+            registered->bActive = true;
+            registered->Type = type;
+            types[registered->Index] = type;
+            continue;
+        }
+
+        FRegisteredTag entry;
+        entry.Index = tags.Add(tag);
+        entry.Type = type;
+        entry.bActive = true;
+        types.Add(type);
+        tagIndices.Add(tag, entry);
+    }
+}
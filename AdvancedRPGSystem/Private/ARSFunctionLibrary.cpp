@@ -1,10 +1,10 @@
 // Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
 
 #include "ARSFunctionLibrary.h"
+#include "ARSAttributeRegistry.h"
 #include "ARSDeveloperSettings.h"
 #include "ARSGenerationRulesDataAsset.h"
 #include "ARSTypes.h"
-#include <GameplayTagsManager.h>
 
 bool UARSFunctionLibrary::TryGetGenerationRuleByPrimaryAttributeType(const FGameplayTag& PrimaryAttributeTag, FGenerationRule& outRule)
 {
@@ -106,23 +106,17 @@ FString UARSFunctionLibrary::FromAttributeTagToReadableName(FGameplayTag attribu
 
 bool UARSFunctionLibrary::IsValidStatisticTag(FGameplayTag TagToCheck)
 {
-    const FGameplayTag root = GetStatisticsTagRoot();
-
-    return UGameplayTagsManager::Get().RequestGameplayTagChildren(root).HasTag(TagToCheck);
+    return FARSAttributeRegistry::Get().IsValidTag(TagToCheck, EStatisticsType::EStatistic);
 }
 
 bool UARSFunctionLibrary::IsValidAttributeTag(FGameplayTag TagToCheck)
 {
-    const FGameplayTag root = GetAttributesTagRoot();
-
-    return UGameplayTagsManager::Get().RequestGameplayTagChildren(root).HasTag(TagToCheck);
+    return FARSAttributeRegistry::Get().IsValidTag(TagToCheck, EStatisticsType::EPrimaryAttribute);
 }
 
 bool UARSFunctionLibrary::IsValidParameterTag(FGameplayTag TagToCheck)
 {
-    const FGameplayTag root = GetParametersTagRoot();
-
-    return UGameplayTagsManager::Get().RequestGameplayTagChildren(root).HasTag(TagToCheck);
+    return FARSAttributeRegistry::Get().IsValidTag(TagToCheck, EStatisticsType::ESecondaryAttribute);
 }
 
 FGameplayTag UARSFunctionLibrary::GetHealthTag()
@@ -4,6 +4,20 @@
 #include "ARSTypes.h"
 #include "GameplayTagContainer.h"
 
+void UARSGenerationRulesDataAsset::PostLoad()
+{
+    Super::PostLoad();
+    BuildDependencies();
+}
+
+#if WITH_EDITOR
+void UARSGenerationRulesDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    BuildDependencies();
+}
+#endif
+
 bool UARSGenerationRulesDataAsset::TryGetGenerationRulesForPrimaryAttributes(const FGameplayTag& primaryAttribute, FGenerationRule& outRule) const
 {
     if (AttributesGenerationRules.Contains(primaryAttribute)) {
@@ -12,3 +26,132 @@ bool UARSGenerationRulesDataAsset::TryGetGenerationRulesForPrimaryAttributes(con
     }
     return false;
 }
+
+void UARSGenerationRulesDataAsset::GetInfluencedTags(const FGameplayTag& primaryAttribute, TArray<FGameplayTag>& outParameters, TArray<FGameplayTag>& outStatistics)
+{
+    if (!bDependenciesBuilt) {
+        BuildDependencies();
+    }
+
+    if (const TArray<FGameplayTag>* params = influencedParameters.Find(primaryAttribute)) {
+        outParameters.Append(*params);
+    }
+    if (const TArray<FGameplayTag>* stats = influencedStatistics.Find(primaryAttribute)) {
+        outStatistics.Append(*stats);
+    }
+}
+
+const TArray<FARSInfluenceSource>* UARSGenerationRulesDataAsset::GetParameterSources(const FGameplayTag& parameter)
+{
+    if (!bDependenciesBuilt) {
+        BuildDependencies();
+    }
+    return parameterSources.Find(parameter);
+}
+
+const TArray<FARSInfluenceSource>* UARSGenerationRulesDataAsset::GetStatisticSources(const FGameplayTag& statistic)
+{
+    if (!bDependenciesBuilt) {
+        BuildDependencies();
+    }
+    return statisticSources.Find(statistic);
+}
+
+void UARSGenerationRulesDataAsset::GetAllGeneratedTags(TArray<FGameplayTag>& outParameters, TArray<FGameplayTag>& outStatistics)
+{
+    if (!bDependenciesBuilt) {
+        BuildDependencies();
+    }
+
+    for (const auto& source : parameterSources) {
+        outParameters.Add(source.Key);
+    }
+    for (const auto& source : statisticSources) {
+        outStatistics.Add(source.Key);
+    }
+}
+
+void UARSGenerationRulesDataAsset::BuildDependencies()
+{
+    parameterSources.Reset();
+    statisticSources.Reset();
+    influencedParameters.Reset();
+    influencedStatistics.Reset();
+
+#if WITH_EDITOR
+    for (const TWeakObjectPtr<UCurveFloat>& curve : watchedCurves) {
+        if (curve.IsValid()) {
+            curve->OnUpdateCurve.RemoveAll(this);
+        }
+    }
+    watchedCurves.Reset();
+#endif
+
+    for (const FGenerationRule& rule : AttributesGenerationRules) {
+        for (const FAttributeInfluence& att : rule.InfluencedParameters) {
+            if (!att.CurveValue) {
+                continue;
+            }
+            FARSInfluenceSource source;
+            source.PrimaryAttribute = rule.PrimaryAttributesTag;
+            source.CurveValue = att.CurveValue;
+            source.BakedValue.Bake(att.CurveValue);
+#if WITH_EDITOR
+            WatchCurve(att.CurveValue);
+#endif
+            parameterSources.FindOrAdd(att.TargetParameter).Add(source);
+            influencedParameters.FindOrAdd(rule.PrimaryAttributesTag).AddUnique(att.TargetParameter);
+        }
+
+        for (const FStatInfluence& stat : rule.InfluencedStatistics) {
+            if (!stat.CurveMaxValue && !stat.CurveRegenValue) {
+                continue;
+            }
+            FARSInfluenceSource source;
+            source.PrimaryAttribute = rule.PrimaryAttributesTag;
+            source.CurveValue = stat.CurveMaxValue;
+            source.CurveRegenValue = stat.CurveRegenValue;
+            source.BakedValue.Bake(stat.CurveMaxValue);
+            source.BakedRegenValue.Bake(stat.CurveRegenValue);
+#if WITH_EDITOR
+            WatchCurve(stat.CurveMaxValue);
+            WatchCurve(stat.CurveRegenValue);
+#endif
+            statisticSources.FindOrAdd(stat.TargetStat).Add(source);
+            influencedStatistics.FindOrAdd(rule.PrimaryAttributesTag).AddUnique(stat.TargetStat);
+        }
+    }
+    bDependenciesBuilt = true;
+}
+
+#if WITH_EDITOR
+void UARSGenerationRulesDataAsset::WatchCurve(UCurveFloat* curve)
+{
+    if (curve && !watchedCurves.Contains(curve)) {
+        watchedCurves.Add(curve);
+        curve->OnUpdateCurve.AddUObject(this, &UARSGenerationRulesDataAsset::HandleCurveUpdated);
+    }
+}
+
+void UARSGenerationRulesDataAsset::HandleCurveUpdated(UCurveBase* curve, EPropertyChangeType::Type changeType)
+{
+    // Baked in place, statistics components of a running session keep pointers to the sources
+    for (TPair<FGameplayTag, TArray<FARSInfluenceSource>>& sources : parameterSources) {
+        for (FARSInfluenceSource& source : sources.Value) {
+            if (source.CurveValue == curve) {
+                source.BakedValue.Bake(source.CurveValue);
+            }
+        }
+    }
+    for (TPair<FGameplayTag, TArray<FARSInfluenceSource>>& sources : statisticSources) {
+        for (FARSInfluenceSource& source : sources.Value) {
+            if (source.CurveValue == curve) {
+                source.BakedValue.Bake(source.CurveValue);
+            }
+            if (source.CurveRegenValue == curve) {
+                source.BakedRegenValue.Bake(source.CurveRegenValue);
+            }
+        }
+    }
+}
+#endif
@@ -3,16 +3,65 @@
 
 #include "ARSLevelingSystemDataAsset.h"
 
+void UARSLevelingSystemDataAsset::PostLoad()
+{
+    Super::PostLoad();
+    BakeCurves();
+}
+
+#if WITH_EDITOR
+void UARSLevelingSystemDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    BakeCurves();
+}
+#endif
+
 void UARSLevelingSystemDataAsset::GetAllAttributesValueByLevel(const int32 level, TArray<FAttribute>& outAttributes) const
 {
-    for (const auto& localatt : AttributesByLevelCurves) {
+    const bool bBaked = bakedCurves.Num() == AttributesByLevelCurves.Num();
+    for (int32 index = 0; index < AttributesByLevelCurves.Num(); index++) {
+        const FAttributesByLevel& localatt = AttributesByLevelCurves[index];
         if (localatt.ValueByLevelCurve) {
-            FAttribute item(localatt.PrimaryAttributesTag, localatt.ValueByLevelCurve->GetFloatValue(level));
+            const float value = bBaked ? bakedCurves[index].Evaluate(level) : localatt.ValueByLevelCurve->GetFloatValue(level);
+            FAttribute item(localatt.PrimaryAttributesTag, value);
             outAttributes.AddUnique(item);
         }
     }
 }
 
+void UARSLevelingSystemDataAsset::BakeCurves()
+{
+    bakedCurves.SetNum(AttributesByLevelCurves.Num());
+    for (int32 index = 0; index < AttributesByLevelCurves.Num(); index++) {
+        bakedCurves[index].Bake(AttributesByLevelCurves[index].ValueByLevelCurve);
+    }
 
+#if WITH_EDITOR
+    // Editing a curve doesn't touch this asset, its tables are baked again when the curve notifies the change
+    for (const TWeakObjectPtr<UCurveFloat>& curve : watchedCurves) {
+        if (curve.IsValid()) {
+            curve->OnUpdateCurve.RemoveAll(this);
+        }
+    }
+    watchedCurves.Reset();
+    for (const FAttributesByLevel& attribute : AttributesByLevelCurves) {
+        UCurveFloat* curve = attribute.ValueByLevelCurve;
+        if (curve && !watchedCurves.Contains(curve)) {
+            watchedCurves.Add(curve);
+            curve->OnUpdateCurve.AddUObject(this, &UARSLevelingSystemDataAsset::HandleCurveUpdated);
+        }
+    }
+#endif
+}
 
-
+#if WITH_EDITOR
+void UARSLevelingSystemDataAsset::HandleCurveUpdated(UCurveBase* curve, EPropertyChangeType::Type changeType)
+{
+    for (int32 index = 0; index < AttributesByLevelCurves.Num() && index < bakedCurves.Num(); index++) {
+        if (AttributesByLevelCurves[index].ValueByLevelCurve == curve) {
+            bakedCurves[index].Bake(AttributesByLevelCurves[index].ValueByLevelCurve);
+        }
+    }
+}
+#endif
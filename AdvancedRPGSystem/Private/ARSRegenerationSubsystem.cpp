@@ -0,0 +1,177 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ARSRegenerationSubsystem.h"
+#include "ARSDeveloperSettings.h"
+#include "ARSStatisticsComponent.h"
+#include "ARSStats.h"
+#include <Engine/World.h>
+
+DECLARE_CYCLE_STAT(TEXT("Regeneration Tick"), STAT_ARSRegenerationTick, STATGROUP_ARS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Regenerated Statistics"), STAT_ARSRegeneratedStatistics, STATGROUP_ARS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Regenerating Statistics"), STAT_ARSRegeneratingStatistics, STATGROUP_ARS);
+
+void UARSRegenerationSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ARSRegenerationTick);
+
+    const int32 numEntries = statTags.Num();
+    SET_DWORD_STAT(STAT_ARSRegeneratingStatistics, numEntries);
+    if (numEntries == 0) {
+        return;
+    }
+
+    const UARSDeveloperSettings* settings = GetDefault<UARSDeveloperSettings>();
+    const int32 budget = settings->MaxRegenerationsPerFrame > 0 ? FMath::Min(settings->MaxRegenerationsPerFrame, numEntries) : numEntries;
+    const float now = GetGameTime();
+
+    // Components are only touched once the pass is over, as they can unregister while handling the change
+    pendingRegenerations.Reset();
+    for (int32 processed = 0; processed < budget; processed++) {
+        if (cursor >= numEntries) {
+            cursor = 0;
+        }
+        const int32 index = cursor++;
+
+        if (now < nextUpdateTimes[index]) {
+            continue;
+        }
+        const float elapsed = now - lastUpdateTimes[index];
+        lastUpdateTimes[index] = now;
+        nextUpdateTimes[index] = now + intervals[index];
+
+        if (now < delayEnds[index]) {
+            continue;
+        }
+
+        const float newValue = FMath::Clamp(currentValues[index] + regenRates[index] * elapsed, minValues[index], maxValues[index]);
+        if (newValue != currentValues[index]) {
+            pendingRegenerations.Emplace(components[index], FStatisticValue(statTags[index], newValue - currentValues[index]));
+            currentValues[index] = newValue;
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_ARSRegeneratedStatistics, pendingRegenerations.Num());
+    for (const auto& regeneration : pendingRegenerations) {
+        if (UARSStatisticsComponent* statComp = regeneration.Key.Get()) {
+            statComp->ApplyRegeneration(regeneration.Value);
+        }
+    }
+}
+
+TStatId UARSRegenerationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UARSRegenerationSubsystem, STATGROUP_Tickables);
+}
+
+void UARSRegenerationSubsystem::SyncComponent(UARSStatisticsComponent* statComp, const TArray<FStatistic>& statistics, float interval)
+{
+    TArray<FGameplayTag> regenerating;
+    for (const FStatistic& statistic : statistics) {
+        if (statistic.HasRegeneration && statistic.RegenValue != 0.f) {
+            AddOrUpdateEntry(statComp, statistic, interval);
+            regenerating.Add(statistic.StatType);
+        }
+    }
+
+    TArray<FGameplayTag>& registered = componentStatistics.FindOrAdd(statComp);
+    for (const FGameplayTag& statTag : registered) {
+        if (!regenerating.Contains(statTag)) {
+            const int32* index = entryIndices.Find(FRegenerationKey(statComp, statTag));
+            if (index) {
+                RemoveEntry(*index);
+            }
+        }
+    }
+
+    if (regenerating.Num() > 0) {
+        registered = MoveTemp(regenerating);
+    } else {
+        componentStatistics.Remove(statComp);
+    }
+}
+
+void UARSRegenerationSubsystem::UnregisterComponent(UARSStatisticsComponent* statComp)
+{
+    const TArray<FGameplayTag>* registered = componentStatistics.Find(statComp);
+    if (!registered) {
+        return;
+    }
+
+    for (const FGameplayTag& statTag : *registered) {
+        const int32* index = entryIndices.Find(FRegenerationKey(statComp, statTag));
+        if (index) {
+            RemoveEntry(*index);
+        }
+    }
+    componentStatistics.Remove(statComp);
+}
+
+void UARSRegenerationSubsystem::NotifyStatisticModified(const UARSStatisticsComponent* statComp, const FStatistic& statistic, bool bResetDelay)
+{
+    const int32* index = entryIndices.Find(FRegenerationKey(statComp, statistic.StatType));
+    if (!index) {
+        return;
+    }
+
+    currentValues[*index] = statistic.CurrentValue;
+    if (bResetDelay && regenDelays[*index] > 0.f) {
+        delayEnds[*index] = GetGameTime() + regenDelays[*index];
+    }
+}
+
+void UARSRegenerationSubsystem::AddOrUpdateEntry(UARSStatisticsComponent* statComp, const FStatistic& statistic, float interval)
+{
+    int32 index;
+    if (const int32* existing = entryIndices.Find(FRegenerationKey(statComp, statistic.StatType))) {
+        index = *existing;
+    } else {
+        const float now = GetGameTime();
+        index = components.Add(statComp);
+        statTags.Add(statistic.StatType);
+        currentValues.AddZeroed();
+        minValues.AddZeroed();
+        maxValues.AddZeroed();
+        regenRates.AddZeroed();
+        regenDelays.AddZeroed();
+        intervals.AddZeroed();
+        delayEnds.Add(0.f);
+        lastUpdateTimes.Add(now);
+        nextUpdateTimes.Add(now + interval);
+        entryIndices.Add(FRegenerationKey(statComp, statistic.StatType), index);
+    }
+
+    currentValues[index] = statistic.CurrentValue;
+    minValues[index] = statistic.bClampToZero ? 0.f : -BIG_NUMBER;
+    maxValues[index] = statistic.MaxValue;
+    regenRates[index] = statistic.RegenValue;
+    regenDelays[index] = statistic.RegenDelay;
+    intervals[index] = interval;
+}
+
+void UARSRegenerationSubsystem::RemoveEntry(int32 index)
+{
+    entryIndices.Remove(FRegenerationKey(components[index].Get(), statTags[index]));
+
+    const int32 lastIndex = statTags.Num() - 1;
+    if (index != lastIndex) {
+        entryIndices.Add(FRegenerationKey(components[lastIndex].Get(), statTags[lastIndex]), index);
+    }
+
+    components.RemoveAtSwap(index, 1, false);
+    statTags.RemoveAtSwap(index, 1, false);
+    currentValues.RemoveAtSwap(index, 1, false);
+    minValues.RemoveAtSwap(index, 1, false);
+    maxValues.RemoveAtSwap(index, 1, false);
+    regenRates.RemoveAtSwap(index, 1, false);
+    regenDelays.RemoveAtSwap(index, 1, false);
+    intervals.RemoveAtSwap(index, 1, false);
+    delayEnds.RemoveAtSwap(index, 1, false);
+    lastUpdateTimes.RemoveAtSwap(index, 1, false);
+    nextUpdateTimes.RemoveAtSwap(index, 1, false);
+}
+
+float UARSRegenerationSubsystem::GetGameTime() const
+{
+    const UWorld* world = GetWorld();
+    return world ? world->GetTimeSeconds() : 0.f;
+}
@@ -0,0 +1,242 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ARSReplicatedAttributes.h"
+#include "ARSDeveloperSettings.h"
+#include "ARSStatisticsComponent.h"
+
+namespace ARSReplication {
+float GetPrecisionScale(EARSReplicationPrecision precision)
+{
+    switch (precision) {
+    case EARSReplicationPrecision::EHundredths:
+        return 100.f;
+    case EARSReplicationPrecision::ETenths:
+        return 10.f;
+    case EARSReplicationPrecision::EUnits:
+        return 1.f;
+    default:
+        return 0.f;
+    }
+}
+
+float Quantize(float value, EARSReplicationPrecision precision)
+{
+    const float scale = GetPrecisionScale(precision);
+    return scale > 0.f ? FMath::RoundToFloat(value * scale) / scale : value;
+}
+
+// Quantized values are sent as zigzag encoded packed integers
+void SerializeValue(FArchive& Ar, float& value, EARSReplicationPrecision precision)
+{
+    const float scale = GetPrecisionScale(precision);
+    if (scale == 0.f) {
+        Ar << value;
+        return;
+    }
+
+    uint32 packed = 0;
+    if (Ar.IsSaving()) {
+        // Rounded in 64 bits, MAX_int32 is not representable as a float and would overflow the cast
+        const int64 rounded = FMath::RoundToInt64(FMath::Clamp((double)value * scale, (double)MIN_int32, (double)MAX_int32));
+        const int32 quantized = (int32)FMath::Clamp<int64>(rounded, MIN_int32, MAX_int32);
+        packed = (uint32(quantized) << 1) ^ uint32(quantized >> 31);
+    }
+    Ar.SerializeIntPacked(packed);
+    if (Ar.IsLoading()) {
+        const int32 quantized = int32(packed >> 1) ^ -int32(packed & 1);
+        value = quantized / scale;
+    }
+}
+
+void SerializePrecision(FArchive& Ar, EARSReplicationPrecision& precision)
+{
+    uint8 precisionBits = (uint8)precision;
+    Ar.SerializeBits(&precisionBits, 2);
+    precision = (EARSReplicationPrecision)precisionBits;
+}
+}
+
+bool FARSReplicatedAttribute::Set(const FAttribute& attribute, EARSReplicationPrecision inPrecision)
+{
+    const float quantized = ARSReplication::Quantize(attribute.Value, inPrecision);
+    if (AttributeType == attribute.AttributeType && Value == quantized && Precision == inPrecision) {
+        return false;
+    }
+
+    AttributeType = attribute.AttributeType;
+    Value = quantized;
+    Precision = inPrecision;
+    return true;
+}
+
+bool FARSReplicatedAttribute::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    AttributeType.NetSerialize(Ar, Map, bOutSuccess);
+    ARSReplication::SerializePrecision(Ar, Precision);
+    ARSReplication::SerializeValue(Ar, Value, Precision);
+    return true;
+}
+
+void FARSReplicatedAttribute::PreReplicatedRemove(const FARSReplicatedAttributes& InArraySerializer)
+{
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedStateReceived(true);
+    }
+}
+
+void FARSReplicatedAttribute::PostReplicatedAdd(const FARSReplicatedAttributes& InArraySerializer)
+{
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedStateReceived(true);
+    }
+}
+
+void FARSReplicatedAttribute::PostReplicatedChange(const FARSReplicatedAttributes& InArraySerializer)
+{
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedStateReceived(false);
+    }
+}
+
+bool FARSReplicatedAttributes::Sync(const TArray<FAttribute>& attributes)
+{
+    const UARSDeveloperSettings* settings = GetDefault<UARSDeveloperSettings>();
+
+    bool bSameLayout = Items.Num() == attributes.Num();
+    for (int32 index = 0; bSameLayout && index < Items.Num(); index++) {
+        bSameLayout = Items[index].AttributeType == attributes[index].AttributeType;
+    }
+
+    if (!bSameLayout) {
+        Items.Reset(attributes.Num());
+        for (const FAttribute& attribute : attributes) {
+            FARSReplicatedAttribute& item = Items.AddDefaulted_GetRef();
+            item.Set(attribute, settings->GetReplicationPrecision(attribute.AttributeType));
+            MarkItemDirty(item);
+        }
+        MarkArrayDirty();
+        return true;
+    }
+
+    bool bDirty = false;
+    for (int32 index = 0; index < Items.Num(); index++) {
+        if (Items[index].Set(attributes[index], settings->GetReplicationPrecision(attributes[index].AttributeType))) {
+            MarkItemDirty(Items[index]);
+            bDirty = true;
+        }
+    }
+    return bDirty;
+}
+
+void FARSReplicatedAttributes::ToAttributes(TArray<FAttribute>& outAttributes) const
+{
+    outAttributes.Reset(Items.Num());
+    for (const FARSReplicatedAttribute& item : Items) {
+        outAttributes.Add(item.ToAttribute());
+    }
+}
+
+bool FARSReplicatedStatistic::Set(const FStatistic& statistic, EARSReplicationPrecision inPrecision)
+{
+    FStatistic quantized = statistic;
+    quantized.CurrentValue = ARSReplication::Quantize(statistic.CurrentValue, inPrecision);
+    quantized.MaxValue = ARSReplication::Quantize(statistic.MaxValue, inPrecision);
+    quantized.RegenValue = ARSReplication::Quantize(statistic.RegenValue, inPrecision);
+
+    // FStatistic == only compares the tag
+    if (Statistic.StatType == quantized.StatType && Statistic.CurrentValue == quantized.CurrentValue && Statistic.MaxValue == quantized.MaxValue
+        && Statistic.RegenValue == quantized.RegenValue && Statistic.RegenDelay == quantized.RegenDelay && Statistic.HasRegeneration == quantized.HasRegeneration
+        && Statistic.bStartFromZero == quantized.bStartFromZero && Statistic.bClampToZero == quantized.bClampToZero && Precision == inPrecision) {
+        return false;
+    }
+
+    Statistic = quantized;
+    Precision = inPrecision;
+    return true;
+}
+
+bool FARSReplicatedStatistic::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    Statistic.StatType.NetSerialize(Ar, Map, bOutSuccess);
+    ARSReplication::SerializePrecision(Ar, Precision);
+    ARSReplication::SerializeValue(Ar, Statistic.CurrentValue, Precision);
+    ARSReplication::SerializeValue(Ar, Statistic.MaxValue, Precision);
+    ARSReplication::SerializeValue(Ar, Statistic.RegenValue, Precision);
+    Ar << Statistic.RegenDelay;
+
+    uint8 flags = (Statistic.HasRegeneration ? 1 : 0) | (Statistic.bStartFromZero ? 2 : 0) | (Statistic.bClampToZero ? 4 : 0);
+    Ar.SerializeBits(&flags, 3);
+    Statistic.HasRegeneration = (flags & 1) != 0;
+    Statistic.bStartFromZero = (flags & 2) != 0;
+    Statistic.bClampToZero = (flags & 4) != 0;
+    return true;
+}
+
+void FARSReplicatedStatistic::PreReplicatedRemove(const FARSReplicatedStatistics& InArraySerializer)
+{
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedStateReceived(true);
+    }
+}
+
+void FARSReplicatedStatistic::PostReplicatedAdd(const FARSReplicatedStatistics& InArraySerializer)
+{
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedStateReceived(true);
+    }
+}
+
+void FARSReplicatedStatistic::PostReplicatedChange(const FARSReplicatedStatistics& InArraySerializer)
+{
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedStateReceived(false);
+    }
+}
+
+bool FARSReplicatedStatistics::Sync(const TArray<FStatistic>& statistics)
+{
+    bool bSameLayout = Items.Num() == statistics.Num();
+    for (int32 index = 0; bSameLayout && index < Items.Num(); index++) {
+        bSameLayout = Items[index].Statistic.StatType == statistics[index].StatType;
+    }
+
+    if (!bSameLayout) {
+        const UARSDeveloperSettings* settings = GetDefault<UARSDeveloperSettings>();
+        Items.Reset(statistics.Num());
+        for (const FStatistic& statistic : statistics) {
+            FARSReplicatedStatistic& item = Items.AddDefaulted_GetRef();
+            item.Set(statistic, settings->GetReplicationPrecision(statistic.StatType));
+            MarkItemDirty(item);
+        }
+        MarkArrayDirty();
+        return true;
+    }
+
+    bool bDirty = false;
+    for (int32 index = 0; index < Items.Num(); index++) {
+        bDirty |= SyncItem(index, statistics[index]);
+    }
+    return bDirty;
+}
+
+bool FARSReplicatedStatistics::SyncItem(int32 index, const FStatistic& statistic)
+{
+    if (!ensure(Items.IsValidIndex(index))) {
+        return false;
+    }
+
+    FARSReplicatedStatistic& item = Items[index];
+    if (item.Set(statistic, GetDefault<UARSDeveloperSettings>()->GetReplicationPrecision(statistic.StatType))) {
+        MarkItemDirty(item);
+        return true;
+    }
+    return false;
+}
+
+void FARSReplicatedStatistics::ToStatistics(TArray<FStatistic>& outStatistics) const
+{
+    outStatistics.Reset(Items.Num());
+    for (const FARSReplicatedStatistic& item : Items) {
+        outStatistics.Add(item.Statistic);
+    }
+}
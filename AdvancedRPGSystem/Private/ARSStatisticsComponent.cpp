@@ -1,15 +1,19 @@
 // Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
 
 #include "ARSStatisticsComponent.h"
+#include "ARSAttributeRegistry.h"
 #include "ARSFunctionLibrary.h"
+#include "ARSGenerationRulesDataAsset.h"
 #include "ARSLevelingSystemDataAsset.h"
+#include "ARSRegenerationSubsystem.h"
 #include "ARSTypes.h"
+#include "Algo/BinarySearch.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Net/UnrealNetwork.h"
 #include <Curves/CurveFloat.h>
 #include <Engine/World.h>
 #include <Kismet/GameplayStatics.h>
 #include <Kismet/KismetSystemLibrary.h>
-#include <TimerManager.h>
 
 // Sets default values for this component's properties
 UARSStatisticsComponent::UARSStatisticsComponent()
@@ -17,22 +21,113 @@ UARSStatisticsComponent::UARSStatisticsComponent()
     // Set this component to be initialized when the game starts, and to be ticked
     // every frame.  You can turn these features off to improve performance if you
     // don't need them.
-    PrimaryComponentTick.bCanEverTick = false;
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
 
     SetIsReplicatedByDefault(true);
     // ...
     CharacterLevel = 1;
+
+    ReplicatedPrimaryAttributes.Owner = this;
+    ReplicatedParameters.Owner = this;
+    ReplicatedStatistics.Owner = this;
 }
 
 void UARSStatisticsComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(UARSStatisticsComponent, AttributeSet);
-    DOREPLIFETIME(UARSStatisticsComponent, CurrentExps);
-    DOREPLIFETIME(UARSStatisticsComponent, ExpToNextLevel);
-    DOREPLIFETIME(UARSStatisticsComponent, Perks);
-    DOREPLIFETIME(UARSStatisticsComponent, baseAttributeSet);
+    FDoRepLifetimeParams params;
+    params.bIsPushBased = true;
+
+    DOREPLIFETIME_WITH_PARAMS_FAST(UARSStatisticsComponent, ReplicatedPrimaryAttributes, params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UARSStatisticsComponent, ReplicatedParameters, params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UARSStatisticsComponent, ReplicatedStatistics, params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UARSStatisticsComponent, CurrentExps, params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UARSStatisticsComponent, ExpToNextLevel, params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UARSStatisticsComponent, Perks, params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UARSStatisticsComponent, baseAttributeSet, params);
+}
+
+void UARSStatisticsComponent::MarkPushPropertiesDirty()
+{
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, CurrentExps, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, ExpToNextLevel, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, Perks, this);
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, baseAttributeSet, this);
+}
+
+void UARSStatisticsComponent::SyncReplicatedAttributes()
+{
+    if (GetOwnerRole() != ROLE_Authority) {
+        return;
+    }
+
+    if (ReplicatedPrimaryAttributes.Sync(AttributeSet.Attributes)) {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, ReplicatedPrimaryAttributes, this);
+    }
+    if (ReplicatedParameters.Sync(AttributeSet.Parameters)) {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, ReplicatedParameters, this);
+    }
+    if (ReplicatedStatistics.Sync(AttributeSet.Statistics)) {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, ReplicatedStatistics, this);
+    }
+}
+
+void UARSStatisticsComponent::SyncReplicatedStatistic(const FStatistic& statistic)
+{
+    if (GetOwnerRole() != ROLE_Authority) {
+        return;
+    }
+
+    // Items mirror the AttributeSet, so the position of the statistic is the position of its item
+    const int32 index = UE_PTRDIFF_TO_INT32(&statistic - AttributeSet.Statistics.GetData());
+    const TArray<FARSReplicatedStatistic>& items = ReplicatedStatistics.Items;
+    if (!items.IsValidIndex(index) || items[index].Statistic.StatType != statistic.StatType) {
+        SyncReplicatedAttributes();
+        return;
+    }
+
+    if (ReplicatedStatistics.SyncItem(index, statistic)) {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, ReplicatedStatistics, this);
+    }
+}
+
+void UARSStatisticsComponent::MarkReplicatedStateReceived(bool bLayoutChanged)
+{
+    bPendingReplicatedState = true;
+    bPendingReplicatedLayout |= bLayoutChanged;
+    SetComponentTickEnabled(true);
+}
+
+void UARSStatisticsComponent::ApplyReplicatedAttributes()
+{
+    ReplicatedPrimaryAttributes.ToAttributes(AttributeSet.Attributes);
+    ReplicatedParameters.ToAttributes(AttributeSet.Parameters);
+    ReplicatedStatistics.ToStatistics(AttributeSet.Statistics);
+
+    // Items added on clients are appended, so the order can differ from the server one
+    if (bPendingReplicatedLayout) {
+        AttributeSet.Sort();
+    }
+    InvalidateAttributeSlots();
+
+    bPendingReplicatedState = false;
+    bPendingReplicatedLayout = false;
+    NotifyAttributeSetModified();
+}
+
+void UARSStatisticsComponent::NotifyAttributeSetModified()
+{
+    bPendingAttributeSetModified = true;
+    SetComponentTickEnabled(true);
+}
+
+void UARSStatisticsComponent::SetAvailablePerks(int32 InPerks)
+{
+    Perks = InPerks;
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, Perks, this);
 }
 
 void UARSStatisticsComponent::InitializeAttributeSet()
@@ -61,29 +156,40 @@ void UARSStatisticsComponent::BeginPlay()
 void UARSStatisticsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    // Expired modifiers only mark their stats dirty, they are all recomputed below
+    ExpireTimedModifiers();
+
+    UpdateDirtyStats();
+
+    if (bPendingAttributeSetModified) {
+        bPendingAttributeSetModified = false;
+        OnAttributeSetModified.Broadcast();
+    }
+
+    // Handlers of the broadcasts above can add modifiers or dirty stats again, keep ticking until they are handled too
+    SetComponentTickEnabled(HasDirtyStats() || bPendingAttributeSetModified || bPendingReplicatedState || timedModifiers.Num() > 0);
 }
 
-void UARSStatisticsComponent::RegenerateStat()
+void UARSStatisticsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    for (const auto& elem : AttributeSet.Statistics) {
-        if (elem.HasRegeneration) {
-            if (regenDelay.Contains(elem.StatType)) {
-                FDateTime* before = regenDelay.Find(elem.StatType);
-                if (before) {
-                    const FTimespan delay = FDateTime::Now() - *before;
-                    if (delay.GetSeconds() > elem.RegenDelay) {
-                        regenDelay.Remove(elem.StatType);
-                    } else if (elem.RegenValue != 0.f) {
-                        continue;
-                    }
-                }
-            }
-            FStatisticValue modifier;
-            modifier.Statistic = elem.StatType;
-            modifier.Value = elem.RegenValue * RegenerationTimeInterval;
-            Internal_ModifyStat(modifier, false);
-        }
+    if (regenerationSubsystem) {
+        regenerationSubsystem->UnregisterComponent(this);
     }
+    Super::EndPlay(EndPlayReason);
+}
+
+void UARSStatisticsComponent::SyncRegeneration()
+{
+    if (bIsRegenerationStarted && regenerationSubsystem) {
+        EnsureStatsUpToDate();
+        regenerationSubsystem->SyncComponent(this, AttributeSet.Statistics, RegenerationTimeInterval);
+    }
+}
+
+void UARSStatisticsComponent::ApplyRegeneration(const FStatisticValue& regeneration)
+{
+    Internal_ModifyStat(regeneration, false);
 }
 
 void UARSStatisticsComponent::AddAttributeSetModifier_Implementation(const FAttributesSetModifier& attModifier)
@@ -105,110 +211,480 @@ void UARSStatisticsComponent::AddAttributeSetModifier_Implementation(const FAttr
 void UARSStatisticsComponent::Internal_AddModifier(const FAttributesSetModifier& attModifier)
 {
 
-    activeModifiers.AddUnique(attModifier);
+    if (activeModifiers.Contains(attModifier)) {
+        return;
+    }
+
+    activeModifiers.Add(attModifier);
+    AggregateModifier(attModifier, 1);
+}
+
+bool UARSStatisticsComponent::Internal_RemoveModifier(const FAttributesSetModifier& attModifier)
+{
+    const int32 index = activeModifiers.IndexOfByKey(attModifier);
+    if (index == INDEX_NONE) {
+        return false;
+    }
 
-    GenerateStats();
+    AggregateModifier(activeModifiers[index], -1);
+    activeModifiers.RemoveAt(index);
+    return true;
 }
 
-void UARSStatisticsComponent::GenerateStats()
+void UARSStatisticsComponent::ScheduleModifierExpiration(const FAttributesSetModifier& attModifier, float duration)
 {
+    FARSTimedModifier timedModifier;
+    timedModifier.Modifier = attModifier;
+    timedModifier.ExpireTime = GetWorldTime() + duration;
+    timedModifiers.HeapPush(timedModifier);
+    SetComponentTickEnabled(true);
+}
 
-    TArray<FStatistic> currentValuesCopy;
-    for (const FStatistic& stat : AttributeSet.Statistics) {
-        currentValuesCopy.Add(stat);
+void UARSStatisticsComponent::ExpireTimedModifiers()
+{
+    if (timedModifiers.Num() == 0) {
+        return;
+    }
+
+    const double now = GetWorldTime();
+    while (timedModifiers.Num() > 0 && timedModifiers.HeapTop().ExpireTime <= now) {
+        FARSTimedModifier expired;
+        timedModifiers.HeapPop(expired);
+        Internal_RemoveModifier(expired.Modifier);
     }
+}
 
-    CalcualtePrimaryStats();
-    GenerateSecondaryStat();
+void UARSStatisticsComponent::SaveTimedModifiers()
+{
+    savedTimedModifiers.Reset(timedModifiers.Num());
 
-    for (FStatistic& stat : AttributeSet.Statistics) {
-        FStatistic* oldStat = currentValuesCopy.FindByKey(stat);
-        if (oldStat) {
-            stat.CurrentValue = UARSFunctionLibrary::GetNewCurrentValueForNewMaxValue(oldStat->CurrentValue, oldStat->MaxValue, stat.MaxValue);
-        }
+    const double now = GetWorldTime();
+    for (const FARSTimedModifier& timedModifier : timedModifiers) {
+        FARSTimedModifier& saved = savedTimedModifiers.Add_GetRef(timedModifier);
+        saved.RemainingTime = FMath::Max(static_cast<float>(timedModifier.ExpireTime - now), 0.f);
     }
-    AttributeSet.Sort();
-    OnAttributeSetModified.Broadcast();
 }
 
+void UARSStatisticsComponent::RestoreTimedModifiers()
+{
+    // The running modifiers belong to the state that has just been replaced by the loaded one
+    for (const FARSTimedModifier& timedModifier : timedModifiers) {
+        Internal_RemoveModifier(timedModifier.Modifier);
+    }
+    timedModifiers.Reset();
 
-void UARSStatisticsComponent::Internal_ModifyStat(const FStatisticValue& StatMod, bool bResetDelay)
+    for (const FARSTimedModifier& saved : savedTimedModifiers) {
+        Internal_AddModifier(saved.Modifier);
+        ScheduleModifierExpiration(saved.Modifier, saved.RemainingTime);
+    }
+    savedTimedModifiers.Empty();
+}
+
+double UARSStatisticsComponent::GetWorldTime() const
 {
-    if (!bIsInitialized)
-        return;
+    const UWorld* world = GetWorld();
+    return world ? world->GetTimeSeconds() : 0.0;
+}
 
-    FStatistic* stat = AttributeSet.Statistics.FindByKey(StatMod.Statistic);
+void UARSStatisticsComponent::GenerateStats()
+{
+    MarkAllStatsDirty();
+    UpdateDirtyStats();
+}
 
-    if (stat) {
-        const float oldValue = stat->CurrentValue;
-        stat->CurrentValue += StatMod.Value; // *GetConsumptionMultiplierByStatistic(stat->StatType);
+UARSGenerationRulesDataAsset* UARSStatisticsComponent::GetGenerationRules()
+{
+    if (!generationRules) {
+        generationRules = UARSFunctionLibrary::GetGenerationRulesData();
+    }
+    return generationRules;
+}
 
-        if (stat->bClampToZero) {
-            stat->CurrentValue = FMath::Clamp(stat->CurrentValue, 0.f, stat->MaxValue);
+void UARSStatisticsComponent::AggregateModifier(const FAttributesSetModifier& attModifier, int32 sign)
+{
+    const FARSAttributeRegistry& registry = FARSAttributeRegistry::Get();
+    if (modifierAggregates.Num() < registry.Num()) {
+        modifierAggregates.SetNum(registry.Num());
+    }
+
+    // Returns false if the tag is not registered for that type
+    const auto accumulate = [&](const FGameplayTag& tag, EStatisticsType type, float value, float regenValue) {
+        const int32 index = registry.GetIndex(tag, type);
+        ensure(index != INDEX_NONE);
+        if (index == INDEX_NONE) {
+            return false;
+        }
+        FARSModifierAggregate& aggregate = modifierAggregates[index];
+        aggregate.NumModifiers += sign;
+        if (aggregate.NumModifiers > 0) {
+            aggregate.Value += sign * value;
+            aggregate.RegenValue += sign * regenValue;
         } else {
-            stat->CurrentValue = FMath::Clamp(stat->CurrentValue, -BIG_NUMBER, stat->MaxValue);
+            aggregate = FARSModifierAggregate();
+        }
+        return true;
+    };
+
+    for (const auto& att : attModifier.PrimaryAttributesMod) {
+        if (accumulate(att.AttributeType, EStatisticsType::EPrimaryAttribute, att.Value, 0.f)) {
+            dirtyPrimaryAttributes.Add(att.AttributeType);
         }
+    }
 
-        if (bResetDelay && stat->HasRegeneration && stat->RegenDelay > 0.f) {
-            regenDelay.Add(stat->StatType, FDateTime::Now());
+    for (const auto& att : attModifier.AttributesMod) {
+        if (accumulate(att.AttributeType, EStatisticsType::ESecondaryAttribute, att.Value, 0.f)) {
+            dirtyParameters.Add(att.AttributeType);
         }
-        // AttributeSet.Sort();
-        if (oldValue != stat->CurrentValue) {
-            OnAttributeSetModified.Broadcast();
-            OnStatisticChanged.Broadcast(stat->StatType, oldValue, stat->CurrentValue);
-            if (FMath::IsNearlyZero(stat->CurrentValue)) {
-                OnStatisiticReachesZero.Broadcast(stat->StatType);
-            }
+    }
+
+    for (const auto& att : attModifier.StatisticsMod) {
+        if (accumulate(att.AttributeType, EStatisticsType::EStatistic, att.MaxValue, att.RegenValue)) {
+            dirtyStatistics.Add(att.AttributeType);
         }
     }
+
+    if (HasDirtyStats()) {
+        SetComponentTickEnabled(true);
+    }
 }
 
-void UARSStatisticsComponent::CalcualtePrimaryStats()
+void UARSStatisticsComponent::MarkPrimaryAttributeDirty(const FGameplayTag& attribute)
 {
-    AttributeSet.Attributes = baseAttributeSet.Attributes;
+    if (StatsLoadMethod == EStatsLoadMethod::EUseDefaultsWithoutGeneration) {
+        return;
+    }
+
+    UARSGenerationRulesDataAsset* rules = GetGenerationRules();
+    if (rules) {
+        TArray<FGameplayTag> params;
+        TArray<FGameplayTag> stats;
+        rules->GetInfluencedTags(attribute, params, stats);
+        dirtyParameters.Append(params);
+        dirtyStatistics.Append(stats);
+    }
+}
+
+void UARSStatisticsComponent::MarkAllStatsDirty()
+{
+    for (const FAttribute& att : baseAttributeSet.Attributes) {
+        dirtyPrimaryAttributes.Add(att.AttributeType);
+    }
+    for (const FAttribute& att : AttributeSet.Attributes) {
+        dirtyPrimaryAttributes.Add(att.AttributeType);
+    }
 
-    for (const FAttributesSetModifier& attModifier : activeModifiers) {
+    for (const FAttribute& att : DefaultAttributeSet.Parameters) {
+        dirtyParameters.Add(att.AttributeType);
+    }
+    for (const FAttribute& att : AttributeSet.Parameters) {
+        dirtyParameters.Add(att.AttributeType);
+    }
 
-        for (const auto& att : attModifier.PrimaryAttributesMod) {
-            ensure(UARSFunctionLibrary::IsValidAttributeTag(att.AttributeType));
-            if (UARSFunctionLibrary::IsValidAttributeTag(att.AttributeType)) {
-                FAttribute* _originalatt = AttributeSet.Attributes.FindByKey(att);
-                if (_originalatt) {
-                    *(_originalatt) = *(_originalatt) + att;
-                } else {
-                    AttributeSet.Attributes.Add(FAttribute(att.AttributeType, att.Value));
+    for (const FStatistic& stat : DefaultAttributeSet.Statistics) {
+        dirtyStatistics.Add(stat.StatType);
+    }
+    for (const FStatistic& stat : AttributeSet.Statistics) {
+        dirtyStatistics.Add(stat.StatType);
+    }
+
+    const FARSAttributeRegistry& registry = FARSAttributeRegistry::Get();
+    for (int32 index = 0; index < modifierAggregates.Num() && index < registry.Num(); index++) {
+        if (modifierAggregates[index].NumModifiers == 0) {
+            continue;
+        }
+        switch (registry.GetType(index)) {
+        case EStatisticsType::EPrimaryAttribute:
+            dirtyPrimaryAttributes.Add(registry.GetTag(index));
+            break;
+        case EStatisticsType::ESecondaryAttribute:
+            dirtyParameters.Add(registry.GetTag(index));
+            break;
+        case EStatisticsType::EStatistic:
+            dirtyStatistics.Add(registry.GetTag(index));
+            break;
+        }
+    }
+
+    UARSGenerationRulesDataAsset* rules = GetGenerationRules();
+    if (rules && StatsLoadMethod != EStatsLoadMethod::EUseDefaultsWithoutGeneration) {
+        TArray<FGameplayTag> params;
+        TArray<FGameplayTag> stats;
+        rules->GetAllGeneratedTags(params, stats);
+        dirtyParameters.Append(params);
+        dirtyStatistics.Append(stats);
+    }
+}
+
+void UARSStatisticsComponent::UpdateDirtyStats()
+{
+    if (bPendingReplicatedState) {
+        ApplyReplicatedAttributes();
+    }
+
+    if (!HasDirtyStats()) {
+        return;
+    }
+
+    bool bLayoutChanged = false;
+
+    // Primary Attributes first, they dirty the Attributes and Statistics generated from them
+    for (const FGameplayTag& attribute : dirtyPrimaryAttributes) {
+        bLayoutChanged |= RecomputePrimaryAttribute(attribute);
+        MarkPrimaryAttributeDirty(attribute);
+    }
+    dirtyPrimaryAttributes.Reset();
+
+    for (const FGameplayTag& parameter : dirtyParameters) {
+        bLayoutChanged |= RecomputeParameter(parameter);
+    }
+    dirtyParameters.Reset();
+
+    for (const FGameplayTag& statistic : dirtyStatistics) {
+        bLayoutChanged |= RecomputeStatistic(statistic);
+    }
+    dirtyStatistics.Reset();
+
+    if (bLayoutChanged) {
+        AttributeSet.Sort();
+        InvalidateAttributeSlots();
+    }
+    SyncReplicatedAttributes();
+    SyncRegeneration();
+    NotifyAttributeSetModified();
+}
+
+bool UARSStatisticsComponent::RecomputePrimaryAttribute(const FGameplayTag& attribute)
+{
+    const FAttribute* baseAtt = baseAttributeSet.Attributes.FindByKey(attribute);
+    const FARSModifierAggregate* aggregate = FindModifierAggregate(attribute, EStatisticsType::EPrimaryAttribute);
+    FAttribute* currentAtt = const_cast<FAttribute*>(FindPrimaryAttribute(attribute));
+
+    if (!baseAtt && !aggregate) {
+        if (currentAtt) {
+            AttributeSet.Attributes.RemoveAll([&attribute](const FAttribute& att) { return att == attribute; });
+            InvalidateAttributeSlots();
+            return true;
+        }
+        return false;
+    }
+
+    const float value = (baseAtt ? baseAtt->Value : 0.f) + (aggregate ? aggregate->Value : 0.f);
+    if (currentAtt) {
+        currentAtt->Value = value;
+        return false;
+    }
+    AttributeSet.Attributes.Add(FAttribute(attribute, value));
+    InvalidateAttributeSlots();
+    return true;
+}
+
+bool UARSStatisticsComponent::RecomputeParameter(const FGameplayTag& parameter)
+{
+    const FAttribute* defaultAtt = DefaultAttributeSet.Parameters.FindByKey(parameter);
+    bool bExists = defaultAtt != nullptr;
+    float value = defaultAtt ? defaultAtt->Value : 0.f;
+
+    UARSGenerationRulesDataAsset* rules = GetGenerationRules();
+    if (rules && StatsLoadMethod != EStatsLoadMethod::EUseDefaultsWithoutGeneration) {
+        if (const TArray<FARSInfluenceSource>* sources = rules->GetParameterSources(parameter)) {
+            for (const FARSInfluenceSource& source : *sources) {
+                const FAttribute* primaryAtt = FindPrimaryAttribute(source.PrimaryAttribute);
+                if (primaryAtt) {
+                    value += source.BakedValue.Evaluate(primaryAtt->Value);
+                    bExists = true;
                 }
             }
         }
     }
+
+    if (const FARSModifierAggregate* aggregate = FindModifierAggregate(parameter, EStatisticsType::ESecondaryAttribute)) {
+        value += aggregate->Value;
+        bExists = true;
+    }
+
+    FAttribute* currentAtt = const_cast<FAttribute*>(FindParameter(parameter));
+    if (!bExists) {
+        if (currentAtt) {
+            AttributeSet.Parameters.RemoveAll([&parameter](const FAttribute& att) { return att == parameter; });
+            InvalidateAttributeSlots();
+            return true;
+        }
+        return false;
+    }
+    if (currentAtt) {
+        currentAtt->Value = value;
+        return false;
+    }
+    AttributeSet.Parameters.Add(FAttribute(parameter, value));
+    InvalidateAttributeSlots();
+    return true;
 }
 
-void UARSStatisticsComponent::CalcualteSecondaryStats()
+bool UARSStatisticsComponent::RecomputeStatistic(const FGameplayTag& statistic)
 {
-    for (const FAttributesSetModifier& attModifier : activeModifiers) {
-        for (const auto& att : attModifier.AttributesMod) {
+    const FStatistic* defaultStat = DefaultAttributeSet.Statistics.FindByKey(statistic);
+    bool bExists = defaultStat != nullptr;
+    FStatistic newStat = defaultStat ? *defaultStat : FStatistic(statistic, 0.f, 0.f);
+
+    UARSGenerationRulesDataAsset* rules = GetGenerationRules();
+    const TArray<FARSInfluenceSource>* sources = nullptr;
+    if (rules && StatsLoadMethod != EStatsLoadMethod::EUseDefaultsWithoutGeneration) {
+        sources = rules->GetStatisticSources(statistic);
+    }
 
-            ensure(UARSFunctionLibrary::IsValidParameterTag(att.AttributeType));
-            if (UARSFunctionLibrary::IsValidParameterTag(att.AttributeType)) {
-                FAttribute* _originalatt = AttributeSet.Parameters.FindByKey(att);
-                if (_originalatt) {
-                    *(_originalatt) = *(_originalatt) + att;
-                } else {
-                    AttributeSet.Parameters.Add(FAttribute(att.AttributeType, att.Value));
-                }
+    if (sources) {
+        for (const FARSInfluenceSource& source : *sources) {
+            const FAttribute* primaryAtt = FindPrimaryAttribute(source.PrimaryAttribute);
+            if (primaryAtt && source.CurveValue) {
+                newStat.MaxValue += source.BakedValue.Evaluate(primaryAtt->Value);
+                bExists = true;
             }
         }
 
-        for (const auto& att : attModifier.StatisticsMod) {
-            ensure(UARSFunctionLibrary::IsValidStatisticTag(att.AttributeType));
-            if (UARSFunctionLibrary::IsValidStatisticTag(att.AttributeType)) {
-                FStatistic* _originalatt = AttributeSet.Statistics.FindByKey(att);
-                if (_originalatt) {
-                    *(_originalatt) = *(_originalatt) + att;
-                } else {
+        // Regeneration is only added to Statistics that actually exist
+        for (const FARSInfluenceSource& source : *sources) {
+            const FAttribute* primaryAtt = FindPrimaryAttribute(source.PrimaryAttribute);
+            if (bExists && primaryAtt && source.CurveRegenValue) {
+                newStat.RegenValue += source.BakedRegenValue.Evaluate(primaryAtt->Value);
+                newStat.HasRegeneration = newStat.RegenValue != 0.f;
+            }
+        }
+    }
 
-                    AttributeSet.Statistics.Add(FStatistic(att.AttributeType, att.MaxValue, att.RegenValue));
-                }
+    if (const FARSModifierAggregate* aggregate = FindModifierAggregate(statistic, EStatisticsType::EStatistic)) {
+        newStat.MaxValue += aggregate->Value;
+        newStat.RegenValue += aggregate->RegenValue;
+        newStat.HasRegeneration = newStat.RegenValue != 0.f;
+        bExists = true;
+    }
+
+    FStatistic* currentStat = FindStatistic(statistic);
+    if (!bExists) {
+        if (currentStat) {
+            AttributeSet.Statistics.RemoveAll([&statistic](const FStatistic& stat) { return stat == statistic; });
+            InvalidateAttributeSlots();
+            return true;
+        }
+        return false;
+    }
+
+    if (currentStat) {
+        newStat.CurrentValue = UARSFunctionLibrary::GetNewCurrentValueForNewMaxValue(currentStat->CurrentValue, currentStat->MaxValue, newStat.MaxValue);
+        *currentStat = newStat;
+        return false;
+    }
+    newStat.CurrentValue = newStat.bStartFromZero ? 0.f : newStat.MaxValue;
+    AttributeSet.Statistics.Add(newStat);
+    InvalidateAttributeSlots();
+    return true;
+}
+
+const FARSModifierAggregate* UARSStatisticsComponent::FindModifierAggregate(const FGameplayTag& tag, EStatisticsType type) const
+{
+    const int32 index = FARSAttributeRegistry::Get().GetIndex(tag, type);
+    if (modifierAggregates.IsValidIndex(index) && modifierAggregates[index].NumModifiers > 0) {
+        return &modifierAggregates[index];
+    }
+    return nullptr;
+}
+
+void UARSStatisticsComponent::RebuildAttributeSlots() const
+{
+    const FARSAttributeRegistry& registry = FARSAttributeRegistry::Get();
+    attributeSlots.Init(INDEX_NONE, registry.Num());
+
+    for (int32 slot = 0; slot < AttributeSet.Attributes.Num(); slot++) {
+        const int32 index = registry.GetIndex(AttributeSet.Attributes[slot].AttributeType, EStatisticsType::EPrimaryAttribute);
+        if (index != INDEX_NONE) {
+            attributeSlots[index] = slot;
+        }
+    }
+    for (int32 slot = 0; slot < AttributeSet.Parameters.Num(); slot++) {
+        const int32 index = registry.GetIndex(AttributeSet.Parameters[slot].AttributeType, EStatisticsType::ESecondaryAttribute);
+        if (index != INDEX_NONE) {
+            attributeSlots[index] = slot;
+        }
+    }
+    for (int32 slot = 0; slot < AttributeSet.Statistics.Num(); slot++) {
+        const int32 index = registry.GetIndex(AttributeSet.Statistics[slot].StatType, EStatisticsType::EStatistic);
+        if (index != INDEX_NONE) {
+            attributeSlots[index] = slot;
+        }
+    }
+    bAttributeSlotsValid = true;
+}
+
+template <typename TValue>
+const TValue* UARSStatisticsComponent::FindInAttributeSet(const TArray<TValue>& values, const FGameplayTag& tag, EStatisticsType type) const
+{
+    const int32 index = FARSAttributeRegistry::Get().GetIndex(tag, type);
+    if (index == INDEX_NONE) {
+        return nullptr;
+    }
+
+    if (!bAttributeSlotsValid || !attributeSlots.IsValidIndex(index)) {
+        RebuildAttributeSlots();
+    }
+
+    int32 slot = attributeSlots[index];
+    if (slot != INDEX_NONE && (!values.IsValidIndex(slot) || values[slot] != tag)) {
+        // The AttributeSet has been replaced as a whole, i.e. by a replication or a load
+        RebuildAttributeSlots();
+        slot = attributeSlots[index];
+    }
+    return slot != INDEX_NONE ? &values[slot] : nullptr;
+}
+
+const FAttribute* UARSStatisticsComponent::FindPrimaryAttribute(const FGameplayTag& attribute) const
+{
+    return FindInAttributeSet(AttributeSet.Attributes, attribute, EStatisticsType::EPrimaryAttribute);
+}
+
+const FAttribute* UARSStatisticsComponent::FindParameter(const FGameplayTag& parameter) const
+{
+    return FindInAttributeSet(AttributeSet.Parameters, parameter, EStatisticsType::ESecondaryAttribute);
+}
+
+const FStatistic* UARSStatisticsComponent::FindStatistic(const FGameplayTag& statistic) const
+{
+    return FindInAttributeSet(AttributeSet.Statistics, statistic, EStatisticsType::EStatistic);
+}
+
+FStatistic* UARSStatisticsComponent::FindStatistic(const FGameplayTag& statistic)
+{
+    return const_cast<FStatistic*>(FindInAttributeSet(AttributeSet.Statistics, statistic, EStatisticsType::EStatistic));
+}
+
+
+void UARSStatisticsComponent::Internal_ModifyStat(const FStatisticValue& StatMod, bool bResetDelay)
+{
+    if (!bIsInitialized)
+        return;
+
+    EnsureStatsUpToDate();
+
+    FStatistic* stat = FindStatistic(StatMod.Statistic);
+
+    if (stat) {
+        const float oldValue = stat->CurrentValue;
+        stat->CurrentValue += StatMod.Value; // *GetConsumptionMultiplierByStatistic(stat->StatType);
+
+        if (stat->bClampToZero) {
+            stat->CurrentValue = FMath::Clamp(stat->CurrentValue, 0.f, stat->MaxValue);
+        } else {
+            stat->CurrentValue = FMath::Clamp(stat->CurrentValue, -BIG_NUMBER, stat->MaxValue);
+        }
+
+        if (regenerationSubsystem && stat->HasRegeneration) {
+            regenerationSubsystem->NotifyStatisticModified(this, *stat, bResetDelay);
+        }
+        // AttributeSet.Sort();
+        if (oldValue != stat->CurrentValue) {
+            SyncReplicatedStatistic(*stat);
+            NotifyAttributeSetModified();
+            OnStatisticChanged.Broadcast(stat->StatType, oldValue, stat->CurrentValue);
+            if (FMath::IsNearlyZero(stat->CurrentValue)) {
+                OnStatisiticReachesZero.Broadcast(stat->StatType);
             }
         }
     }
@@ -216,12 +692,15 @@ void UARSStatisticsComponent::CalcualteSecondaryStats()
 
 FAttributesSetModifier UARSStatisticsComponent::CreateAdditiveAttributeSetModifireFromPercentage(const FAttributesSetModifier& attModifier)
 {
+    // Percentages are resolved against the current values
+    EnsureStatsUpToDate();
+
     FAttributesSetModifier newatt;
     newatt.Guid = attModifier.Guid;
 
     for (const auto& att : attModifier.PrimaryAttributesMod) {
         if (att.ModType == EModifierType::EPercentage) {
-            const FAttribute* originalatt = AttributeSet.Attributes.FindByKey(att);
+            const FAttribute* originalatt = FindPrimaryAttribute(att.AttributeType);
             if (originalatt) {
                 const float newval = originalatt->Value * att.Value / 100.f;
                 const FAttributeModifier newMod(att.AttributeType, EModifierType::EAdditive, newval);
@@ -234,7 +713,7 @@ FAttributesSetModifier UARSStatisticsComponent::CreateAdditiveAttributeSetModifi
     }
     for (const auto& att : attModifier.AttributesMod) {
         if (att.ModType == EModifierType::EPercentage) {
-            const FAttribute* originalatt = AttributeSet.Parameters.FindByKey(att);
+            const FAttribute* originalatt = FindParameter(att.AttributeType);
             if (originalatt) {
                 const float newval = originalatt->Value * att.Value / 100.f;
                 const FAttributeModifier newMod(att.AttributeType, EModifierType::EAdditive, newval);
@@ -246,7 +725,7 @@ FAttributesSetModifier UARSStatisticsComponent::CreateAdditiveAttributeSetModifi
         }
     }
     for (const auto& stat : attModifier.StatisticsMod) {
-        const FStatistic* originalatt = AttributeSet.Statistics.FindByKey(stat);
+        const FStatistic* originalatt = FindStatistic(stat.AttributeType);
         if (stat.ModType == EModifierType::EPercentage) {
             if (originalatt) {
 
@@ -263,82 +742,22 @@ FAttributesSetModifier UARSStatisticsComponent::CreateAdditiveAttributeSetModifi
     return newatt;
 }
 
-void UARSStatisticsComponent::GenerateSecondaryStat()
-{
-    AttributeSet.Parameters = DefaultAttributeSet.Parameters;
-    AttributeSet.Statistics = DefaultAttributeSet.Statistics;
-
-    if (StatsLoadMethod != EStatsLoadMethod::EUseDefaultsWithoutGeneration) {
-        GenerateSecondaryStatFromCurrentPrimaryStat();
-        //         baseAttributeSet.Parameters = AttributeSet.Parameters;
-        //         baseAttributeSet.Statistics = AttributeSet.Statistics;
-    }
-    CalcualteSecondaryStats();
-}
-
-void UARSStatisticsComponent::GenerateSecondaryStatFromCurrentPrimaryStat()
-{
-
-    for (const FAttribute& primaryatt : AttributeSet.Attributes) {
-        FGenerationRule rules;
-
-        if (!UARSFunctionLibrary::TryGetGenerationRuleByPrimaryAttributeType(primaryatt.AttributeType, rules)) {
-
-            return;
-        }
-
-        for (const FAttributeInfluence& att : rules.InfluencedParameters) {
-            if (att.CurveValue) {
-                FAttribute* targetAttribute = AttributeSet.Parameters.FindByKey(att.TargetParameter);
-                if (targetAttribute) {
-                    targetAttribute->Value += att.CurveValue->GetFloatValue(primaryatt.Value);
-                } else {
-                    const float param = att.CurveValue->GetFloatValue(primaryatt.Value);
-                    const FAttribute localatt = FAttribute(att.TargetParameter, param);
-                    AttributeSet.Parameters.AddUnique(localatt);
-                }
-            }
-        }
-
-        for (const FStatInfluence& stat : rules.InfluencedStatistics) {
-
-            if (stat.CurveMaxValue) {
-                FStatistic* targetStat = AttributeSet.Statistics.FindByKey(stat.TargetStat);
-                if (targetStat) {
-                    targetStat->MaxValue += stat.CurveMaxValue->GetFloatValue(primaryatt.Value);
-                    targetStat->CurrentValue = targetStat->bStartFromZero ? 0.f : targetStat->MaxValue;
-                } else {
-                    const float param = stat.CurveMaxValue->GetFloatValue(primaryatt.Value);
-                    const FStatistic localstat = FStatistic(stat.TargetStat, param, 0.f);
-                    AttributeSet.Statistics.AddUnique(localstat);
-                }
-            }
-            FStatistic* targetStat = AttributeSet.Statistics.FindByKey(stat.TargetStat);
-            if (targetStat && stat.CurveRegenValue) {
-                targetStat->RegenValue += stat.CurveRegenValue->GetFloatValue(primaryatt.Value);
-                targetStat->HasRegeneration = targetStat->RegenValue != 0.f;
-            }
-        }
-    }
-}
-
 void UARSStatisticsComponent::StartRegeneration_Implementation()
 {
     if (!bIsRegenerationStarted && bCanRegenerateStatistics) {
         UWorld* world = GetWorld();
         if (world) {
-            world->GetTimerManager().SetTimer(RegenTimer, this, &UARSStatisticsComponent::RegenerateStat, RegenerationTimeInterval, true);
-            bIsRegenerationStarted = true;
+            regenerationSubsystem = world->GetSubsystem<UARSRegenerationSubsystem>();
+            bIsRegenerationStarted = regenerationSubsystem != nullptr;
+            SyncRegeneration();
         }
     }
 }
 
 void UARSStatisticsComponent::StopRegeneration_Implementation()
 {
-    if (bIsRegenerationStarted && RegenTimer.IsValid()) {
-        UWorld* world = GetWorld();
-        // Calling MyUsefulFunction after 5 seconds without looping
-        world->GetTimerManager().ClearTimer(RegenTimer);
+    if (bIsRegenerationStarted && regenerationSubsystem) {
+        regenerationSubsystem->UnregisterComponent(this);
         bIsRegenerationStarted = false;
     }
 }
@@ -359,37 +778,59 @@ void UARSStatisticsComponent::AddExp_Implementation(int32 exp)
 void UARSStatisticsComponent::Internal_AddExp(int32 exp)
 {
     CurrentExps += exp;
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, CurrentExps, this);
 
-    if (CurrentExps >= ExpToNextLevel && CharacterLevel < UARSFunctionLibrary::GetMaxLevel()) {
-        const int32 remainingExps = CurrentExps - ExpToNextLevel;
-        CurrentExps = 0;
-        CharacterLevel++;
-        InitilizeLevelData();
+    const int32 maxLevel = UARSFunctionLibrary::GetMaxLevel();
+    if (CurrentExps < ExpToNextLevel || CharacterLevel >= maxLevel) {
+        return;
+    }
 
-        switch (LevelingType) {
-        case ELevelingType::EGenerateNewStatsFromCurves:
-            Internal_InitializeStats();
-            break;
-        case ELevelingType::EAssignPerksManually:
-            Perks += PerksObtainedOnLevelUp;
-            break;
-        default:
-            UE_LOG(LogTemp, Error, TEXT("A character that cannot level, just leveled! ARSStatisticsComponent"));
-            break;
-        }
-        OnLevelUp(CharacterLevel, remainingExps);
-        Internal_AddExp(remainingExps);
+    BakeLevelingTables();
+    if (!cumulativeExps.IsValidIndex(CharacterLevel)) {
+        return;
+    }
+
+    // Highest level whose requirements are all covered by the exps acquired so far
+    const int32 previousLevel = CharacterLevel;
+    const int64 totalExps = cumulativeExps[previousLevel] + CurrentExps;
+    const int32 newLevel = FMath::Clamp(Algo::UpperBound(cumulativeExps, totalExps) - 1, previousLevel, maxLevel);
+    if (newLevel == previousLevel) {
+        return;
+    }
+
+    int32 remainingExps = CurrentExps;
+    CurrentExps = static_cast<int32>(totalExps - cumulativeExps[newLevel]);
+    CharacterLevel = newLevel;
+    InitilizeLevelData();
+
+    switch (LevelingType) {
+    case ELevelingType::EGenerateNewStatsFromCurves:
+        Internal_InitializeStats();
+        break;
+    case ELevelingType::EAssignPerksManually:
+        Perks += PerksObtainedOnLevelUp * (newLevel - previousLevel);
+        MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, Perks, this);
+        break;
+    default:
+        UE_LOG(LogTemp, Error, TEXT("A character that cannot level, just leveled! ARSStatisticsComponent"));
+        break;
+    }
+
+    for (int32 level = previousLevel + 1; level <= newLevel; level++) {
+        remainingExps -= FMath::Max(expsByLevel[level - 1], 0);
+        OnLevelUp(level, remainingExps);
     }
 }
 
 void UARSStatisticsComponent::RemoveAttributeSetModifier_Implementation(const FAttributesSetModifier& attModifier)
 {
-    FAttributesSetModifier* localmod = activeModifiers.FindByKey(attModifier);
-    if (localmod) {
+    Internal_RemoveModifier(attModifier);
 
-        activeModifiers.RemoveSingle(*(localmod));
-
-        GenerateStats();
+    const int32 timedIndex = timedModifiers.IndexOfByPredicate([&attModifier](const FARSTimedModifier& timedModifier) {
+        return timedModifier.Modifier == attModifier;
+    });
+    if (timedIndex != INDEX_NONE) {
+        timedModifiers.HeapRemoveAt(timedIndex);
     }
 }
 
@@ -422,14 +863,16 @@ bool UARSStatisticsComponent::CheckCosts(const TArray<FStatisticValue>& Costs) c
 
 bool UARSStatisticsComponent::CheckPrimaryAttributesRequirements(const TArray<FAttribute>& Requirements) const
 {
+    EnsureStatsUpToDate();
+
     for (const FAttribute& att : Requirements) {
-        if (!UARSFunctionLibrary::IsValidAttributeTag(att.AttributeType)) {
+        const FAttribute* localatt = FindPrimaryAttribute(att.AttributeType);
+        if (!localatt && !UARSFunctionLibrary::IsValidAttributeTag(att.AttributeType)) {
             UE_LOG(LogTemp, Log,
                 TEXT("Invalid Primary Attribute Tag!!! - "
                      "CheckPrimaryAttributeRequirements"));
             return false;
         }
-        const FAttribute* localatt = AttributeSet.Attributes.FindByKey(att.AttributeType);
         if (localatt && localatt->Value < att.Value)
             return false;
     }
@@ -438,7 +881,9 @@ bool UARSStatisticsComponent::CheckPrimaryAttributesRequirements(const TArray<FA
 
 bool UARSStatisticsComponent::CheckCost(const FStatisticValue& Cost) const
 {
-    const FStatistic* stat = AttributeSet.Statistics.FindByKey(Cost.Statistic);
+    EnsureStatsUpToDate();
+
+    const FStatistic* stat = FindStatistic(Cost.Statistic);
     if (stat) {
         return stat->CurrentValue > (Cost.Value * GetConsumptionMultiplierByStatistic(stat->StatType));
     } else {
@@ -456,11 +901,6 @@ void UARSStatisticsComponent::ConsumeStatistics(const TArray<FStatisticValue>& C
     }
 }
 
-void UARSStatisticsComponent::OnRep_AttributeSet()
-{
-    OnAttributeSetModified.Broadcast();
-}
-
 void UARSStatisticsComponent::Internal_InitializeStats()
 {
     bIsInitialized = false;
@@ -485,6 +925,7 @@ void UARSStatisticsComponent::Internal_InitializeStats()
     default:
         break;
     }
+    InvalidateAttributeSlots();
 
     if (StatsLoadMethod != EStatsLoadMethod::EUseDefaultsWithoutGeneration) {
         GenerateStats();
@@ -495,6 +936,9 @@ void UARSStatisticsComponent::Internal_InitializeStats()
     }
 
     bIsInitialized = true;
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, baseAttributeSet, this);
+    SyncReplicatedAttributes();
+    SyncRegeneration();
 
     for (const FAttributesSetModifier& modifier : storedUnactiveModifiers) {
         AddAttributeSetModifier(modifier);
@@ -525,32 +969,33 @@ void UARSStatisticsComponent::RefillStat(FGameplayTag Stat)
 
 float UARSStatisticsComponent::GetCurrentValueForStatitstic(FGameplayTag stat) const
 {
+    EnsureStatsUpToDate();
 
-    if (!UARSFunctionLibrary::IsValidStatisticTag(stat)) {
-        UE_LOG(LogTemp, Warning, TEXT("INVALID STATISTIC TAG -  -  ARSStatistic Component"));
-        return 0.f;
-    }
-
-    const FStatistic* intStat = AttributeSet.Statistics.FindByKey(stat);
+    const FStatistic* intStat = FindStatistic(stat);
 
     if (intStat) {
         return intStat->CurrentValue;
     }
+
+    if (!UARSFunctionLibrary::IsValidStatisticTag(stat)) {
+        UE_LOG(LogTemp, Warning, TEXT("INVALID STATISTIC TAG -  -  ARSStatistic Component"));
+    }
     return 0.f;
 }
 
 float UARSStatisticsComponent::GetMaxValueForStatitstic(FGameplayTag stat) const
 {
-    if (!UARSFunctionLibrary::IsValidStatisticTag(stat)) {
-        UE_LOG(LogTemp, Warning, TEXT("INVALID STATISTIC TAG -  -  ARSStatistic Component"));
-        return 0.f;
-    }
+    EnsureStatsUpToDate();
 
-    const FStatistic* intStat = AttributeSet.Statistics.FindByKey(stat);
+    const FStatistic* intStat = FindStatistic(stat);
 
     if (intStat) {
         return intStat->MaxValue;
     }
+
+    if (!UARSFunctionLibrary::IsValidStatisticTag(stat)) {
+        UE_LOG(LogTemp, Warning, TEXT("INVALID STATISTIC TAG -  -  ARSStatistic Component"));
+    }
     return 0.f;
 }
 
@@ -569,17 +1014,19 @@ float UARSStatisticsComponent::GetNormalizedValueForStatitstic(FGameplayTag stat
 
 float UARSStatisticsComponent::GetCurrentPrimaryAttributeValue(FGameplayTag attributeTag) const
 {
-    if (!UARSFunctionLibrary::IsValidAttributeTag(attributeTag)) {
-        UE_LOG(LogTemp, Warning, TEXT("INVALID PRIMARY ATTRIBUTE TAG -  -  ARSStatistic Component"));
-        return 0.f;
-    }
+    EnsureStatsUpToDate();
 
-    const FAttribute* intStat = AttributeSet.Attributes.FindByKey(attributeTag);
+    const FAttribute* intStat = FindPrimaryAttribute(attributeTag);
 
     if (intStat) {
         return intStat->Value;
     }
 
+    if (!UARSFunctionLibrary::IsValidAttributeTag(attributeTag)) {
+        UE_LOG(LogTemp, Warning, TEXT("INVALID PRIMARY ATTRIBUTE TAG -  -  ARSStatistic Component"));
+        return 0.f;
+    }
+
     UE_LOG(LogTemp, Warning, TEXT("Missing  Primary Attribute '%s'! -  -  ARSStatistic Component"), *attributeTag.GetTagName().ToString());
 
     return 0.f;
@@ -587,17 +1034,19 @@ float UARSStatisticsComponent::GetCurrentPrimaryAttributeValue(FGameplayTag attr
 
 float UARSStatisticsComponent::GetCurrentAttributeValue(FGameplayTag attributeTag) const
 {
-    if (!UARSFunctionLibrary::IsValidParameterTag(attributeTag)) {
-        UE_LOG(LogTemp, Warning, TEXT("INVALID SECONDARY ATTRIBUTE TAG -  -  ARSStatistic Component"));
-        return 0.f;
-    }
+    EnsureStatsUpToDate();
 
-    const FAttribute* intStat = AttributeSet.Parameters.FindByKey(attributeTag);
+    const FAttribute* intStat = FindParameter(attributeTag);
 
     if (intStat) {
         return intStat->Value;
     }
 
+    if (!UARSFunctionLibrary::IsValidParameterTag(attributeTag)) {
+        UE_LOG(LogTemp, Warning, TEXT("INVALID SECONDARY ATTRIBUTE TAG -  -  ARSStatistic Component"));
+        return 0.f;
+    }
+
     UE_LOG(LogTemp, Warning, TEXT("Missing  Secondary Attribute '%s! - ARSStatistic Component"), *attributeTag.GetTagName().ToString());
 
     return 0.f;
@@ -605,6 +1054,7 @@ float UARSStatisticsComponent::GetCurrentAttributeValue(FGameplayTag attributeTa
 
 FAttributesSet UARSStatisticsComponent::GetCurrentAttributeSet() const
 {
+    EnsureStatsUpToDate();
     return AttributeSet;
 }
 
@@ -631,6 +1081,7 @@ void UARSStatisticsComponent::AssignPerkToPrimaryAttribute_Implementation(FGamep
 
     PermanentlyModifyPrimaryAttribute(attributeTag, numPerks);
     Perks -= numPerks;
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, Perks, this);
 }
 
 void UARSStatisticsComponent::PermanentlyModifyPrimaryAttribute_Implementation(FGameplayTag attribute, float deltaValue /*= 1.0f*/)
@@ -645,9 +1096,32 @@ void UARSStatisticsComponent::PermanentlyModifyPrimaryAttribute_Implementation(F
 }
 void UARSStatisticsComponent::InitilizeLevelData()
 {
+    BakeLevelingTables();
     ExpToNextLevel = GetTotalExpsForLevel(CharacterLevel);
+    MARK_PROPERTY_DIRTY_FROM_NAME(UARSStatisticsComponent, ExpToNextLevel, this);
 }
-int32 UARSStatisticsComponent::GetTotalExpsForLevel(int32 level) const
+
+void UARSStatisticsComponent::BakeLevelingTables()
+{
+    const int32 maxLevel = FMath::Max(UARSFunctionLibrary::GetMaxLevel(), 0);
+    if (bakedExpCurve == ExpForNextLevelCurve && expsByLevel.Num() == maxLevel + 1) {
+        return;
+    }
+
+    bakedExpCurve = ExpForNextLevelCurve;
+    expsByLevel.SetNumUninitialized(maxLevel + 1);
+    cumulativeExps.SetNumUninitialized(maxLevel + 1);
+
+    int64 cumulative = 0;
+    for (int32 level = 0; level <= maxLevel; level++) {
+        expsByLevel[level] = EvaluateExpsForLevel(level);
+        cumulativeExps[level] = cumulative;
+        // Negative requirements are treated as free level ups, keeping the table sorted
+        cumulative += FMath::Max(expsByLevel[level], 0);
+    }
+}
+
+int32 UARSStatisticsComponent::EvaluateExpsForLevel(int32 level) const
 {
     if (ExpForNextLevelCurve) {
         const float nextlevelexp = ExpForNextLevelCurve->GetFloatValue(level);
@@ -656,6 +1130,14 @@ int32 UARSStatisticsComponent::GetTotalExpsForLevel(int32 level) const
     return -1;
 }
 
+int32 UARSStatisticsComponent::GetTotalExpsForLevel(int32 level) const
+{
+    if (bakedExpCurve == ExpForNextLevelCurve && expsByLevel.IsValidIndex(level)) {
+        return expsByLevel[level];
+    }
+    return EvaluateExpsForLevel(level);
+}
+
 int32 UARSStatisticsComponent::GetTotalExpsAcquired() const
 {
     return GetExpsForLevel(CharacterLevel - 1) + GetCurrentExp();
@@ -681,13 +1163,22 @@ TArray<FAttribute> UARSStatisticsComponent::GetPrimitiveAttributesForCurrentLeve
 
 void UARSStatisticsComponent::OnComponentLoaded_Implementation()
 {
+    InvalidateAttributeSlots();
+    if (GetOwnerRole() == ROLE_Authority) {
+        RestoreTimedModifiers();
+    }
     if (StatsLoadMethod != EStatsLoadMethod::EUseDefaultsWithoutGeneration) {
         GenerateStats();
     }
+    MarkPushPropertiesDirty();
+    SyncReplicatedAttributes();
+    SyncRegeneration();
 }
 
 void UARSStatisticsComponent::OnComponentSaved_Implementation()
 {
+    UpdateDirtyStats();
+    SaveTimedModifiers();
 }
 
 TArray<FAttribute> UARSStatisticsComponent::Internal_GetPrimitiveAttributesForCurrentLevel()
@@ -712,13 +1203,9 @@ void UARSStatisticsComponent::AddTimedAttributeSetModifier_Implementation(const
 
     Internal_AddModifier(attModifier);
 
-    FTimerDelegate TimerDel;
-    FTimerHandle TimerHandle;
-    TimerDel.BindUFunction(this, FName("RemoveAttributeSetModifier"), attModifier);
-
-    UWorld* world = GetWorld();
-    if (world) {
-        world->GetTimerManager().SetTimer(TimerHandle, TimerDel, duration, false);
+    // Negative durations never expire
+    if (duration > 0.f) {
+        ScheduleModifierExpiration(attModifier, duration);
     }
 }
 
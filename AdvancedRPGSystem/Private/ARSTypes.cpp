@@ -2,5 +2,52 @@
 
 #include "ARSTypes.h"
 
+void FARSBakedCurve::Bake(const UCurveFloat* inCurve)
+{
+    Reset();
+    Curve = inCurve;
+    if (!Curve) {
+        return;
+    }
 
+    // Data assets bake from their own PostLoad, the curves they reference may not have been post loaded yet
+    const_cast<UCurveFloat*>(Curve)->ConditionalPostLoad();
+    if (Curve->FloatCurve.GetNumKeys() == 0) {
+        return;
+    }
 
+    float minTime = 0.f;
+    float maxTime = 0.f;
+    Curve->FloatCurve.GetTimeRange(minTime, maxTime);
+
+    MinKey = FMath::FloorToInt(minTime);
+    const int32 numSamples = FMath::Min(FMath::CeilToInt(maxTime) - MinKey + 1, MaxSamples);
+
+    Values.SetNumUninitialized(numSamples);
+    for (int32 index = 0; index < numSamples; index++) {
+        Values[index] = Curve->GetFloatValue(static_cast<float>(MinKey + index));
+    }
+}
+
+void FARSBakedCurve::Reset()
+{
+    Curve = nullptr;
+    MinKey = 0;
+    Values.Reset();
+}
+
+float FARSBakedCurve::Evaluate(float key) const
+{
+    const float localKey = key - static_cast<float>(MinKey);
+    if (localKey >= 0.f && localKey <= static_cast<float>(Values.Num() - 1)) {
+        const int32 index = FMath::FloorToInt(localKey);
+        const float alpha = localKey - static_cast<float>(index);
+        if (alpha == 0.f) {
+            return Values[index];
+        }
+        return FMath::Lerp(Values[index], Values[index + 1], alpha);
+    }
+
+    // Out of the baked range, let the curve extrapolate
+    return Curve ? Curve->GetFloatValue(key) : 0.f;
+}
@@ -0,0 +1,54 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "ARSTypes.h"
+#include "CoreMinimal.h"
+#include <GameplayTagContainer.h>
+
+/**
+ * Gives a dense index to every Primary Attribute, Attribute and Statistic tag under the tag roots
+ * defined in the ARS Settings. It is updated on the next use whenever the tag tree or the roots change,
+ * and indices are append-only, so the ones cached by live components stay valid.
+ * Game thread only.
+ */
+class ADVANCEDRPGSYSTEM_API FARSAttributeRegistry {
+public:
+    static FARSAttributeRegistry& Get();
+
+    /*Dense index of the tag, INDEX_NONE if the tag is not a child of the root of that type*/
+    FORCEINLINE int32 GetIndex(const FGameplayTag& tag, EStatisticsType type) const
+    {
+        const FRegisteredTag* entry = tagIndices.Find(tag);
+        return entry && entry->bActive && entry->Type == type ? entry->Index : INDEX_NONE;
+    }
+
+    FORCEINLINE bool IsValidTag(const FGameplayTag& tag, EStatisticsType type) const { return GetIndex(tag, type) != INDEX_NONE; }
+
+    FORCEINLINE const FGameplayTag& GetTag(int32 index) const { return tags[index]; }
+
+    FORCEINLINE EStatisticsType GetType(int32 index) const { return types[index]; }
+
+    FORCEINLINE int32 Num() const { return tags.Num(); }
+
+    void Rebuild();
+
+private:
+    struct FRegisteredTag {
+        int32 Index;
+        EStatisticsType Type;
+        // False once the tag is no longer under a root, its index stays reserved
+        bool bActive;
+    };
+
+    TMap<FGameplayTag, FRegisteredTag> tagIndices;
+    TArray<FGameplayTag> tags;
+    TArray<EStatisticsType> types;
+
+    // Set when the tag tree or the tag roots change, the registry is updated on its next use
+    bool bDirty = true;
+
+    bool bListening = false;
+
+    void RegisterChildren(const FGameplayTag& root, EStatisticsType type);
+};
@@ -40,6 +40,25 @@ public:
     UPROPERTY(EditAnywhere, config, Category = ARS)
     int32 MaxLevel = 100;
 
+    /*Max amount of regenerating Statistics updated in a single frame, the remaining ones
+        are updated in the following frames. 0 means no limit*/
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 0), Category = "ARS | Regeneration")
+    int32 MaxRegenerationsPerFrame = 512;
+
+    /*Precision used to replicate the values of Attributes and Statistics that are not in ReplicationPrecisionOverrides.
+        Lower precisions save bandwidth, as small changes are not sent at all*/
+    UPROPERTY(EditAnywhere, config, Category = "ARS | Replication")
+    EARSReplicationPrecision DefaultReplicationPrecision = EARSReplicationPrecision::EFull;
+
+    UPROPERTY(EditAnywhere, config, Category = "ARS | Replication")
+    TMap<FGameplayTag, EARSReplicationPrecision> ReplicationPrecisionOverrides;
+
+    EARSReplicationPrecision GetReplicationPrecision(const FGameplayTag& attribute) const
+    {
+        const EARSReplicationPrecision* precision = ReplicationPrecisionOverrides.Find(attribute);
+        return precision ? *precision : DefaultReplicationPrecision;
+    }
+
     UARSGenerationRulesDataAsset* GetAttributesGenerationRules() const
     {
         return Cast<UARSGenerationRulesDataAsset>(AttributesGenerationConfig.TryLoad());
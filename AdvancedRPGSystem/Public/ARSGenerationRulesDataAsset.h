@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ARSTypes.h"
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 
@@ -15,11 +16,49 @@ class ADVANCEDRPGSYSTEM_API UARSGenerationRulesDataAsset : public UPrimaryDataAs
     GENERATED_BODY()
 
 public:
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
     UFUNCTION(BlueprintCallable, Category = ARS)
     bool TryGetGenerationRulesForPrimaryAttributes(const FGameplayTag& primaryAttribute, FGenerationRule& outRule) const;
 
+    /*Attributes and Statistics that have to be regenerated when the provided Primary Attribute changes*/
+    void GetInfluencedTags(const FGameplayTag& primaryAttribute, TArray<FGameplayTag>& outParameters, TArray<FGameplayTag>& outStatistics);
+
+    /*Every Primary Attribute that generates the provided Attribute, nullptr if it is not generated*/
+    const TArray<FARSInfluenceSource>* GetParameterSources(const FGameplayTag& parameter);
+
+    /*Every Primary Attribute that generates the provided Statistic, nullptr if it is not generated*/
+    const TArray<FARSInfluenceSource>* GetStatisticSources(const FGameplayTag& statistic);
+
+    /*All the Attributes and Statistics generated by at least one rule*/
+    void GetAllGeneratedTags(TArray<FGameplayTag>& outParameters, TArray<FGameplayTag>& outStatistics);
+
 protected:
     /*Define with Curves how your Attributes generates your Parameters and your Statistics */
     UPROPERTY(EditAnywhere, meta = (TitleProperty = "PrimaryAttributesTag"), Category = ARS)
     TArray<FGenerationRule> AttributesGenerationRules;
+
+private:
+    // Dependency graph of the rules, in both directions. Sources carry their curves baked at load
+    TMap<FGameplayTag, TArray<FARSInfluenceSource>> parameterSources;
+    TMap<FGameplayTag, TArray<FARSInfluenceSource>> statisticSources;
+    TMap<FGameplayTag, TArray<FGameplayTag>> influencedParameters;
+    TMap<FGameplayTag, TArray<FGameplayTag>> influencedStatistics;
+
+    bool bDependenciesBuilt = false;
+
+    void BuildDependencies();
+
+#if WITH_EDITOR
+    // Curves the sources were baked from, edited curves are baked again
+    TArray<TWeakObjectPtr<UCurveFloat>> watchedCurves;
+
+    void WatchCurve(UCurveFloat* curve);
+
+    void HandleCurveUpdated(UCurveBase* curve, EPropertyChangeType::Type changeType);
+#endif
 };
@@ -19,6 +19,11 @@ class ADVANCEDRPGSYSTEM_API UARSLevelingSystemDataAsset : public UPrimaryDataAss
     GENERATED_BODY()
 
 public: 
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
     void GetAllAttributesValueByLevel(const int32 level, TArray<FAttribute>& outAttributes) const;
 
@@ -27,4 +32,16 @@ public:
  protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ARS")
     TArray<FAttributesByLevel> AttributesByLevelCurves;
+
+private:
+    // One baked curve for every entry of AttributesByLevelCurves
+    TArray<FARSBakedCurve> bakedCurves;
+
+    void BakeCurves();
+
+#if WITH_EDITOR
+    TArray<TWeakObjectPtr<UCurveFloat>> watchedCurves;
+
+    void HandleCurveUpdated(UCurveBase* curve, EPropertyChangeType::Type changeType);
+#endif
 };
@@ -0,0 +1,73 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "ARSTypes.h"
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include <GameplayTagContainer.h>
+
+#include "ARSRegenerationSubsystem.generated.h"
+
+class UARSStatisticsComponent;
+
+/**
+ * Regenerates the Statistics of every Statistics Component of the world in a single pass,
+ * using game time so that time dilation and pause are respected
+ */
+UCLASS()
+class ADVANCEDRPGSYSTEM_API UARSRegenerationSubsystem : public UTickableWorldSubsystem {
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override;
+
+    /*Starts or updates the regeneration of all the regenerating Statistics of the component,
+        stopping the ones that no longer regenerate*/
+    void SyncComponent(UARSStatisticsComponent* statComp, const TArray<FStatistic>& statistics, float interval);
+
+    /*Stops the regeneration of all the Statistics of the component*/
+    void UnregisterComponent(UARSStatisticsComponent* statComp);
+
+    /*Keeps the regeneration in sync with a Statistic that has been modified by its component*/
+    void NotifyStatisticModified(const UARSStatisticsComponent* statComp, const FStatistic& statistic, bool bResetDelay);
+
+    FORCEINLINE int32 GetNumRegeneratingStatistics() const { return statTags.Num(); }
+
+private:
+    typedef TPair<const UARSStatisticsComponent*, FGameplayTag> FRegenerationKey;
+
+    // One entry per regenerating Statistic, in parallel arrays
+    UPROPERTY()
+    TArray<TObjectPtr<UARSStatisticsComponent>> components;
+
+    TArray<FGameplayTag> statTags;
+    TArray<float> currentValues;
+    TArray<float> minValues;
+    TArray<float> maxValues;
+    TArray<float> regenRates;
+    TArray<float> regenDelays;
+    TArray<float> intervals;
+
+    // Game time, in seconds
+    TArray<float> delayEnds;
+    TArray<float> lastUpdateTimes;
+    TArray<float> nextUpdateTimes;
+
+    TMap<FRegenerationKey, int32> entryIndices;
+
+    TMap<const UARSStatisticsComponent*, TArray<FGameplayTag>> componentStatistics;
+
+    // Next entry to update, large populations are spread across frames
+    int32 cursor = 0;
+
+    TArray<TPair<TWeakObjectPtr<UARSStatisticsComponent>, FStatisticValue>> pendingRegenerations;
+
+    void AddOrUpdateEntry(UARSStatisticsComponent* statComp, const FStatistic& statistic, float interval);
+
+    void RemoveEntry(int32 index);
+
+    float GetGameTime() const;
+};
@@ -0,0 +1,137 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "ARSTypes.h"
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include <GameplayTagContainer.h>
+
+#include "ARSReplicatedAttributes.generated.h"
+
+class UARSStatisticsComponent;
+
+/*Replicated copy of a single Primary Attribute or Attribute*/
+USTRUCT()
+struct FARSReplicatedAttribute : public FFastArraySerializerItem {
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    FGameplayTag AttributeType;
+
+    UPROPERTY()
+    float Value = 0.f;
+
+    UPROPERTY()
+    EARSReplicationPrecision Precision = EARSReplicationPrecision::EFull;
+
+    /*Returns true if the quantized value is different from the replicated one*/
+    bool Set(const FAttribute& attribute, EARSReplicationPrecision inPrecision);
+
+    FORCEINLINE FAttribute ToAttribute() const { return FAttribute(AttributeType, Value); }
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    void PreReplicatedRemove(const struct FARSReplicatedAttributes& InArraySerializer);
+    void PostReplicatedAdd(const struct FARSReplicatedAttributes& InArraySerializer);
+    void PostReplicatedChange(const struct FARSReplicatedAttributes& InArraySerializer);
+};
+
+template <>
+struct TStructOpsTypeTraits<FARSReplicatedAttribute> : public TStructOpsTypeTraitsBase2<FARSReplicatedAttribute> {
+    enum {
+        WithNetSerializer = true,
+    };
+};
+
+USTRUCT()
+struct FARSReplicatedAttributes : public FFastArraySerializer {
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    TArray<FARSReplicatedAttribute> Items;
+
+    UARSStatisticsComponent* Owner = nullptr;
+
+    /*Mirrors the provided attributes, in the same order, dirtying only the items that changed.
+        Returns true if anything has to be replicated*/
+    bool Sync(const TArray<FAttribute>& attributes);
+
+    void ToAttributes(TArray<FAttribute>& outAttributes) const;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FARSReplicatedAttribute, FARSReplicatedAttributes>(Items, DeltaParms, *this);
+    }
+};
+
+template <>
+struct TStructOpsTypeTraits<FARSReplicatedAttributes> : public TStructOpsTypeTraitsBase2<FARSReplicatedAttributes> {
+    enum {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+/*Replicated copy of a single Statistic*/
+USTRUCT()
+struct FARSReplicatedStatistic : public FFastArraySerializerItem {
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    FStatistic Statistic;
+
+    UPROPERTY()
+    EARSReplicationPrecision Precision = EARSReplicationPrecision::EFull;
+
+    /*Returns true if the quantized statistic is different from the replicated one*/
+    bool Set(const FStatistic& statistic, EARSReplicationPrecision inPrecision);
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    void PreReplicatedRemove(const struct FARSReplicatedStatistics& InArraySerializer);
+    void PostReplicatedAdd(const struct FARSReplicatedStatistics& InArraySerializer);
+    void PostReplicatedChange(const struct FARSReplicatedStatistics& InArraySerializer);
+};
+
+template <>
+struct TStructOpsTypeTraits<FARSReplicatedStatistic> : public TStructOpsTypeTraitsBase2<FARSReplicatedStatistic> {
+    enum {
+        WithNetSerializer = true,
+    };
+};
+
+USTRUCT()
+struct FARSReplicatedStatistics : public FFastArraySerializer {
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    TArray<FARSReplicatedStatistic> Items;
+
+    UARSStatisticsComponent* Owner = nullptr;
+
+    /*Mirrors the provided statistics, in the same order, dirtying only the items that changed.
+        Returns true if anything has to be replicated*/
+    bool Sync(const TArray<FStatistic>& statistics);
+
+    /*Updates a single statistic, index is its position in the array passed to Sync.
+        Returns true if anything has to be replicated*/
+    bool SyncItem(int32 index, const FStatistic& statistic);
+
+    void ToStatistics(TArray<FStatistic>& outStatistics) const;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FARSReplicatedStatistic, FARSReplicatedStatistics>(Items, DeltaParms, *this);
+    }
+};
+
+template <>
+struct TStructOpsTypeTraits<FARSReplicatedStatistics> : public TStructOpsTypeTraitsBase2<FARSReplicatedStatistics> {
+    enum {
+        WithNetDeltaSerializer = true,
+    };
+};
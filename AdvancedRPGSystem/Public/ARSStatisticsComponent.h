@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ARSReplicatedAttributes.h"
 #include "ARSTypes.h"
 #include "Components/ActorComponent.h"
 #include "CoreMinimal.h"
@@ -30,6 +31,8 @@ protected:
     // Called when the game starts
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /*If this is set to true, InitializeAttributeSet is called automatically On BeginPlay serverside.
         If false you have to manually initialize this component when needed*/
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ARS | AttributeSet")
@@ -104,8 +107,6 @@ private:
     UPROPERTY(SaveGame, Replicated)
     int32 CurrentExps;
 
-    TMap<FGameplayTag, FDateTime> regenDelay;
-
     UPROPERTY(SaveGame, Replicated)
     int32 ExpToNextLevel;
 
@@ -115,24 +116,63 @@ private:
     TArray<FAttributesSetModifier> storedUnactiveModifiers;
 
     UPROPERTY()
-    FTimerHandle RegenTimer;
+    class UARSRegenerationSubsystem* regenerationSubsystem = nullptr;
 
     UPROPERTY()
     bool bIsRegenerationStarted = false;
 
     TArray<FAttribute> Internal_GetPrimitiveAttributesForCurrentLevel();
 
-    void RegenerateStat();
+    /*ExpForNextLevelCurve baked for every level up to the max one. cumulativeExps[level] is the
+        sum of the exps required by all the previous levels, so that exp gains are resolved with a binary search*/
+    TArray<int32> expsByLevel;
+
+    TArray<int64> cumulativeExps;
+
+    const UCurveFloat* bakedExpCurve = nullptr;
+
+    void BakeLevelingTables();
+
+    int32 EvaluateExpsForLevel(int32 level) const;
+
+    /*Hands the regenerating Statistics over to the Regeneration Subsystem*/
+    void SyncRegeneration();
 
-    UPROPERTY(SaveGame, ReplicatedUsing = OnRep_AttributeSet)
+    /*Authoritative on server, rebuilt from the replicated items on clients*/
+    UPROPERTY(SaveGame)
     FAttributesSet AttributeSet;
 
+    UPROPERTY(Replicated)
+    FARSReplicatedAttributes ReplicatedPrimaryAttributes;
+
+    UPROPERTY(Replicated)
+    FARSReplicatedAttributes ReplicatedParameters;
+
+    UPROPERTY(Replicated)
+    FARSReplicatedStatistics ReplicatedStatistics;
+
+    bool bPendingReplicatedState = false;
+
+    bool bPendingReplicatedLayout = false;
+
+    bool bPendingAttributeSetModified = false;
+
+    /*Mirrors the AttributeSet in the replicated items, server side*/
+    void SyncReplicatedAttributes();
+
+    void SyncReplicatedStatistic(const FStatistic& statistic);
+
+    /*Rebuilds the AttributeSet from the replicated items, client side*/
+    void ApplyReplicatedAttributes();
+
+    /*OnAttributeSetModified is broadcast once per frame, no matter how many changes happened*/
+    void NotifyAttributeSetModified();
+
+    void MarkPushPropertiesDirty();
+
     UPROPERTY(SaveGame, Replicated)
     int32 Perks = 0;
 
-    UFUNCTION()
-    void OnRep_AttributeSet();
-
     void Internal_InitializeStats();
 
     UPROPERTY(SaveGame, Replicated)
@@ -153,13 +193,82 @@ private:
     UFUNCTION()
     void Internal_AddModifier(const FAttributesSetModifier& modifier);
 
-    void CalcualtePrimaryStats();
-    void CalcualteSecondaryStats();
+    bool Internal_RemoveModifier(const FAttributesSetModifier& modifier);
+
+    /*Min heap of the timed modifiers ordered by expire time, drained once per frame by the tick*/
+    UPROPERTY()
+    TArray<FARSTimedModifier> timedModifiers;
+
+    /*Timed modifiers with their remaining time, filled right before this component is saved*/
+    UPROPERTY(SaveGame)
+    TArray<FARSTimedModifier> savedTimedModifiers;
+
+    void ScheduleModifierExpiration(const FAttributesSetModifier& modifier, float duration);
+
+    void ExpireTimedModifiers();
+
+    void SaveTimedModifiers();
+
+    void RestoreTimedModifiers();
+
+    double GetWorldTime() const;
 
     FAttributesSetModifier CreateAdditiveAttributeSetModifireFromPercentage(const FAttributesSetModifier& _modifier);
 
-    void GenerateSecondaryStat();
-    void GenerateSecondaryStatFromCurrentPrimaryStat();
+    /*Sum of the active modifiers of every registered tag, indexed by FARSAttributeRegistry index*/
+    TArray<FARSModifierAggregate> modifierAggregates;
+
+    const FARSModifierAggregate* FindModifierAggregate(const FGameplayTag& tag, EStatisticsType type) const;
+
+    /*Position of every registered tag in its AttributeSet array, indexed by FARSAttributeRegistry index*/
+    mutable TArray<int32> attributeSlots;
+
+    mutable bool bAttributeSlotsValid = false;
+
+    void RebuildAttributeSlots() const;
+
+    FORCEINLINE void InvalidateAttributeSlots() { bAttributeSlotsValid = false; }
+
+    template <typename TValue>
+    const TValue* FindInAttributeSet(const TArray<TValue>& values, const FGameplayTag& tag, EStatisticsType type) const;
+
+    const FAttribute* FindPrimaryAttribute(const FGameplayTag& attribute) const;
+    const FAttribute* FindParameter(const FGameplayTag& parameter) const;
+    const FStatistic* FindStatistic(const FGameplayTag& statistic) const;
+    FStatistic* FindStatistic(const FGameplayTag& statistic);
+
+    /*Values waiting to be recomputed, at the end of the frame or on the first read*/
+    TSet<FGameplayTag> dirtyPrimaryAttributes;
+    TSet<FGameplayTag> dirtyParameters;
+    TSet<FGameplayTag> dirtyStatistics;
+
+    UPROPERTY()
+    class UARSGenerationRulesDataAsset* generationRules = nullptr;
+
+    class UARSGenerationRulesDataAsset* GetGenerationRules();
+
+    void AggregateModifier(const FAttributesSetModifier& modifier, int32 sign);
+
+    void MarkPrimaryAttributeDirty(const FGameplayTag& attribute);
+
+    void MarkAllStatsDirty();
+
+    FORCEINLINE bool HasDirtyStats() const { return bPendingReplicatedState || dirtyPrimaryAttributes.Num() > 0 || dirtyParameters.Num() > 0 || dirtyStatistics.Num() > 0; }
+
+    /*Brings the AttributeSet up to date with the dirty values or the replicated ones*/
+    void UpdateDirtyStats();
+
+    FORCEINLINE void EnsureStatsUpToDate() const
+    {
+        if (HasDirtyStats()) {
+            const_cast<UARSStatisticsComponent*>(this)->UpdateDirtyStats();
+        }
+    }
+
+    // Return true if the value was added or removed from the AttributeSet
+    bool RecomputePrimaryAttribute(const FGameplayTag& attribute);
+    bool RecomputeParameter(const FGameplayTag& parameter);
+    bool RecomputeStatistic(const FGameplayTag& statistic);
 
     // Regenerate Stats
     UFUNCTION(BlueprintCallable, Category = ARS)
@@ -171,6 +280,12 @@ public:
     // Called every frame
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+    /*Called by the replicated items when new values are received*/
+    void MarkReplicatedStateReceived(bool bLayoutChanged);
+
+    /*Called by the Regeneration Subsystem when a regenerating Statistic changes*/
+    void ApplyRegeneration(const FStatisticValue& regeneration);
+
     /*Starts to regenerate all the Statistics with a regeneration value != 0.f.
         Server Side*/
     UFUNCTION(Server, Reliable, BlueprintCallable, Category = ARS)
@@ -254,7 +369,7 @@ public:
 
     /* Sets the amount of available perks*/ 
     UFUNCTION(BlueprintCallable, Category = ARS)
-    void SetAvailablePerks(int32 InPerks) { Perks = InPerks; };
+    void SetAvailablePerks(int32 InPerks);
 
     /*Getter Current value for Statistic*/
     UFUNCTION(BlueprintCallable, Category = ARS)
@@ -347,13 +462,25 @@ public:
 
     /*Indicates if there is a statistic with this tag in the AttributeSet*/
     UFUNCTION(BlueprintCallable, Category = ARS)
-    bool HasValidStatistic(FGameplayTag stat) const { return AttributeSet.Statistics.Contains(stat); };
+    bool HasValidStatistic(FGameplayTag stat) const
+    {
+        EnsureStatsUpToDate();
+        return FindStatistic(stat) != nullptr;
+    };
 
     UFUNCTION(BlueprintCallable, Category = ARS)
-    bool HasValidAttribute(FGameplayTag param) const { return AttributeSet.Parameters.Contains(param); };
+    bool HasValidAttribute(FGameplayTag param) const
+    {
+        EnsureStatsUpToDate();
+        return FindParameter(param) != nullptr;
+    };
 
     UFUNCTION(BlueprintCallable, Category = ARS)
-    bool HasValidPrimaryAttribute(FGameplayTag att) const { return AttributeSet.Attributes.Contains(att); };
+    bool HasValidPrimaryAttribute(FGameplayTag att) const
+    {
+        EnsureStatsUpToDate();
+        return FindPrimaryAttribute(att) != nullptr;
+    };
 
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = ARS)
     void OnComponentLoaded();
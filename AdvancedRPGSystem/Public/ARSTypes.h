@@ -41,6 +41,14 @@ enum class EStatisticsType : uint8 {
     ESecondaryAttribute UMETA(DisplayName = "Attributes"),
 };
 
+UENUM(BlueprintType)
+enum class EARSReplicationPrecision : uint8 {
+    EFull = 0 UMETA(DisplayName = "Full Precision"),
+    EHundredths UMETA(DisplayName = "Two Decimals"),
+    ETenths UMETA(DisplayName = "One Decimal"),
+    EUnits UMETA(DisplayName = "No Decimals"),
+};
+
 USTRUCT(BlueprintType)
 struct FBaseModifier {
     GENERATED_BODY()
@@ -373,6 +381,25 @@ public:
     ~FAttributesSetModifier() {};
 };
 
+/*A modifier removed by the Statistics Component once its expire time is reached*/
+USTRUCT()
+struct FARSTimedModifier {
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(SaveGame)
+    FAttributesSetModifier Modifier;
+
+    // World time at which the modifier expires, only meaningful while active
+    double ExpireTime = 0.0;
+
+    // Time left before the expiration, only meaningful while saved
+    UPROPERTY(SaveGame)
+    float RemainingTime = 0.f;
+
+    FORCEINLINE bool operator<(const FARSTimedModifier& Other) const { return ExpireTime < Other.ExpireTime; }
+};
+
 USTRUCT(BlueprintType)
 struct FStatisticValue {
     GENERATED_BODY()
@@ -456,6 +483,52 @@ public:
     TArray<FAttributeInfluence> InfluencedParameters;
 };
 
+/*A UCurveFloat sampled once for every integer key of its range. Fractional keys are linearly
+interpolated between the two closest samples, keys outside of the baked range fall back to the curve*/
+struct ADVANCEDRPGSYSTEM_API FARSBakedCurve {
+    // Upper bound of the samples taken for a single curve
+    static constexpr int32 MaxSamples = 4096;
+
+    void Bake(const UCurveFloat* inCurve);
+
+    void Reset();
+
+    float Evaluate(float key) const;
+
+    FORCEINLINE bool IsBaked() const { return Values.Num() > 0; }
+
+private:
+    const UCurveFloat* Curve = nullptr;
+
+    int32 MinKey = 0;
+
+    TArray<float> Values;
+};
+
+/*A Primary Attribute that contributes to an Attribute or a Statistic through the curves of its generation rule*/
+struct FARSInfluenceSource {
+    FGameplayTag PrimaryAttribute;
+
+    // Value curve for Attributes, MaxValue curve for Statistics
+    UCurveFloat* CurveValue = nullptr;
+
+    UCurveFloat* CurveRegenValue = nullptr;
+
+    FARSBakedCurve BakedValue;
+
+    FARSBakedCurve BakedRegenValue;
+};
+
+/*Running sum of all the active modifiers of a single Primary Attribute, Attribute or Statistic*/
+struct FARSModifierAggregate {
+    // Value for Attributes, MaxValue for Statistics
+    float Value = 0.f;
+
+    float RegenValue = 0.f;
+
+    int32 NumModifiers = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FAttributesByLevel {
     GENERATED_BODY()
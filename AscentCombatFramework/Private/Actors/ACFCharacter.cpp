@@ -7,6 +7,7 @@
 #include "ARSStatisticsComponent.h"
 #include "ATSBaseTargetComponent.h"
 #include "ATSTargetingComponent.h"
+#include "ATSTargetingSubsystem.h"
 #include "Animation/ACFAnimInstance.h"
 #include "CCMFadeableActorComponent.h"
 #include "Components/ACFCharacterMovementComponent.h"
@@ -421,6 +422,9 @@ void AACFCharacter::ClientsOnCharacterDeath_Implementation()
         GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
         GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Camera, ECR_Ignore);
     }
+    if (UATSTargetingSubsystem* targetingSubsystem = GetWorld()->GetSubsystem<UATSTargetingSubsystem>()) {
+        targetingSubsystem->NotifyTargetDeath(this);
+    }
     OnCharacterDeath();
 }
 
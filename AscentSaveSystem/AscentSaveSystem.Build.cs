@@ -41,7 +41,9 @@ public class AscentSaveSystem : ModuleRules
 				"Slate",
 				"SlateCore",
 				"DeveloperSettings",
-				"ImageWrapper"
+				"ImageWrapper",
+				"RenderCore",
+				"RHI"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -1,26 +1,25 @@
 // Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
 
 #include "ALSFunctionLibrary.h"
+#include "ALSLoadAndSaveComponent.h"
 #include "ALSLoadAndSaveSubsystem.h"
+#include "ALSSavableComponentInterface.h"
 #include "ALSSavableInterface.h"
+#include "ALSSaveContainer.h"
 #include "ALSSaveGameSettings.h"
 #include "ALSSaveTypes.h"
+#include "ALSThumbnail.h"
 #include "Engine/Engine.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/Texture2D.h"
 #include "GameFramework/Pawn.h"
 #include "HighResScreenshot.h"
-#include "IImageWrapper.h"
-#include "IImageWrapperModule.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
-#include "Modules/ModuleManager.h"
-#include "Serialization/BulkData.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
-#include "TextureResource.h"
 #include "Kismet/KismetSystemLibrary.h"
 
 bool UALSFunctionLibrary::TrySaveSceenshot(const FString& fileName, const int32 width /*= 640*/, const int32 height /*= 480*/)
@@ -50,24 +49,17 @@ FString UALSFunctionLibrary::ConstructScreenshotPath(const FString& fileName)
 
 UTexture2D* UALSFunctionLibrary::GetScreenshotByName(const FString& fileName)
 {
-    UTexture2D* Texture { nullptr };
-    const FString path = ConstructScreenshotPath(fileName);
+    // Thumbnail stored in the save first, screenshot taken by previous versions otherwise
     TArray<uint8> RawFileData;
-    if (GEngine && FFileHelper::LoadFileToArray(RawFileData, *path)) {
-        IImageWrapperModule& imgWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-        TSharedPtr<IImageWrapper> imgWrapper = imgWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-        if (imgWrapper.IsValid() && imgWrapper->SetCompressed(RawFileData.GetData(), RawFileData.Num())) {
-            TArray64<uint8> UncompressedBGRA;
-            if (imgWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA)) {
-                Texture = UTexture2D::CreateTransient(imgWrapper->GetWidth(), imgWrapper->GetHeight(), PF_B8G8R8A8);
-                void* TextureData = Texture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-                FMemory::Memcpy(TextureData, UncompressedBGRA.GetData(), UncompressedBGRA.Num());
-                Texture->GetPlatformData()->Mips[0].BulkData.Unlock();
-                Texture->UpdateResource();
-            }
-        }
+    if (!FALSSaveContainer::ReadThumbnail(fileName, RawFileData) && !FFileHelper::LoadFileToArray(RawFileData, *ConstructScreenshotPath(fileName), FILEREAD_Silent)) {
+        return nullptr;
     }
-    return Texture;
+
+    FALSThumbnailPixels pixels;
+    if (GEngine && FALSThumbnailCodec::DecodePNG(RawFileData, pixels)) {
+        return FALSThumbnailCodec::CreateTexture(pixels);
+    }
+    return nullptr;
 }
 
 bool UALSFunctionLibrary::ShouldSaveActor(AActor* actor)
@@ -78,6 +70,15 @@ bool UALSFunctionLibrary::ShouldSaveActor(AActor* actor)
     return false;
 }
 
+void UALSFunctionLibrary::MarkActorDirty(AActor* actor)
+{
+    if (IsValid(actor)) {
+        if (UALSLoadAndSaveComponent* saveComp = actor->FindComponentByClass<UALSLoadAndSaveComponent>()) {
+            saveComp->MarkDirty();
+        }
+    }
+}
+
 bool UALSFunctionLibrary::IsNewGame(const UObject* WorldContextObject)
 {
     return UGameplayStatics::GetGameInstance(WorldContextObject)->GetSubsystem<UALSLoadAndSaveSubsystem>()->GetLoadType() == ELoadType::EDontReload;
@@ -96,12 +97,90 @@ bool UALSFunctionLibrary::IsSpecialActor(const UObject* WorldContextObject, cons
     return false;
 }
 
+namespace ALSComponentCallbacks {
+
+/** How the save and load hooks of a component class are called */
+struct FClassCallbacks {
+    bool bNative = false;
+
+    // Looked up by the names in the settings, called when the class doesn't implement the native interface
+    TWeakObjectPtr<UFunction> onSaved;
+    TWeakObjectPtr<UFunction> onLoaded;
+};
+
+static FRWLock CacheLock;
+static TMap<TObjectKey<UClass>, FClassCallbacks> CachedClasses;
+
+static FClassCallbacks Resolve(UClass* componentClass)
+{
+    {
+        FReadScopeLock readLock(CacheLock);
+        const FClassCallbacks* cached = CachedClasses.Find(componentClass);
+        // A stale function means the class was recompiled, it is resolved again
+        if (cached && !cached->onSaved.IsStale() && !cached->onLoaded.IsStale()) {
+            return *cached;
+        }
+    }
+
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    FClassCallbacks callbacks;
+    callbacks.onSaved = componentClass->FindFunctionByName(saveSettings->GetOnComponentSavedFunctionName());
+    callbacks.onLoaded = componentClass->FindFunctionByName(saveSettings->GetOnComponentLoadedFunctionName());
+
+    // Blueprints overriding the hooks of a native class still need their script to run
+    const bool bScriptOverride = (callbacks.onSaved.IsValid() && !callbacks.onSaved->HasAnyFunctionFlags(FUNC_Native))
+        || (callbacks.onLoaded.IsValid() && !callbacks.onLoaded->HasAnyFunctionFlags(FUNC_Native));
+    callbacks.bNative = !bScriptOverride && componentClass->ImplementsInterface(UALSSavableComponentInterface::StaticClass());
+
+    FWriteScopeLock writeLock(CacheLock);
+    CachedClasses.Add(componentClass, callbacks);
+    return callbacks;
+}
+}
+
 void UALSFunctionLibrary::ExecuteFunctionsOnSavableComponents(const AActor* actorOwner, const FName& functionName)
 {
-    TArray<UActorComponent*> Components = IALSSavableInterface::Execute_GetComponentsToSave(actorOwner);
+    const TArray<UActorComponent*> Components = IALSSavableInterface::Execute_GetComponentsToSave(actorOwner);
+
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    if (functionName == saveSettings->GetOnComponentSavedFunctionName()) {
+        ExecuteComponentCallbacks(Components, EALSComponentCallback::ESaved);
+        return;
+    }
+    if (functionName == saveSettings->GetOnComponentLoadedFunctionName()) {
+        ExecuteComponentCallbacks(Components, EALSComponentCallback::ELoaded);
+        return;
+    }
+
     for (auto component : Components) {
+        UFunction* func = component ? component->FindFunction(functionName) : nullptr;
+        if (func) {
+            component->ProcessEvent(func, nullptr);
+        }
+    }
+}
 
-        UFunction* func = component->FindFunction(functionName);
+void UALSFunctionLibrary::ExecuteComponentCallbacks(const TArray<UActorComponent*>& components, const EALSComponentCallback callback)
+{
+    for (UActorComponent* component : components) {
+        if (!component) {
+            continue;
+        }
+
+        const ALSComponentCallbacks::FClassCallbacks callbacks = ALSComponentCallbacks::Resolve(component->GetClass());
+        if (callbacks.bNative) {
+            IALSSavableComponentInterface* savable = static_cast<IALSSavableComponentInterface*>(component->GetInterfaceAddress(UALSSavableComponentInterface::StaticClass()));
+            if (savable) {
+                if (callback == EALSComponentCallback::ESaved) {
+                    savable->NativeOnComponentSaved();
+                } else {
+                    savable->NativeOnComponentLoaded();
+                }
+            }
+            continue;
+        }
+
+        UFunction* func = callback == EALSComponentCallback::ESaved ? callbacks.onSaved.Get() : callbacks.onLoaded.Get();
         if (func) {
             component->ProcessEvent(func, nullptr);
         }
@@ -115,17 +194,30 @@ void UALSFunctionLibrary::ExecuteFunctionsOnSavableActor(AActor* actorOwner, con
         functionName);
 }
 
+// A loaded owner no longer matches the record it was last saved with, even in the same slot
+static void MarkLoadedOwnerDirty(const AActor* Actor)
+{
+    if (UALSLoadAndSaveComponent* SaveComp = Actor ? Actor->FindComponentByClass<UALSLoadAndSaveComponent>() : nullptr) {
+        SaveComp->MarkDirty();
+    }
+}
+
 void UALSFunctionLibrary::DeserializeActor(AActor* Actor, const FALSActorData& Record)
 {
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    DeserializeActor(Actor, Record, IALSSavableInterface::Execute_GetComponentsToSave(Actor));
+}
+
+void UALSFunctionLibrary::DeserializeActor(AActor* Actor, const FALSActorData& Record, const TArray<UActorComponent*>& Components)
+{
     Actor->Tags = Record.Tags;
 
     Actor->SetActorHiddenInGame(Record.bHiddenInGame);
-    UALSFunctionLibrary::DeserializeActorComponents(Actor, Record);
+    UALSFunctionLibrary::DeserializeComponents(Components, Record);
 
     FMemoryReader MemoryReader(Record.Data, true);
     FALSSaveGameArchive Archive(MemoryReader, false);
     Actor->Serialize(Archive);
+    MarkLoadedOwnerDirty(Actor);
 }
 
 void UALSFunctionLibrary::FullDeserializeActor(AActor* Actor, const FALSActorData& Record, bool bLoadTransform)
@@ -134,11 +226,17 @@ void UALSFunctionLibrary::FullDeserializeActor(AActor* Actor, const FALSActorDat
     if (!bLoadTransform) {
         oldTrans = Actor->GetTransform();
     }
-    DeserializeActor(Actor, Record);
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    if (UKismetSystemLibrary::DoesImplementInterface( Actor, UALSSavableInterface::StaticClass())) {
-        ExecuteFunctionsOnSavableActor(Actor, saveSettings->GetOnComponentLoadedFunctionName());
+
+    if (UKismetSystemLibrary::DoesImplementInterface(Actor, UALSSavableInterface::StaticClass())) {
+        // Components are listed once for both the restore and the callbacks
+        const TArray<UActorComponent*> Components = IALSSavableInterface::Execute_GetComponentsToSave(Actor);
+        DeserializeActor(Actor, Record, Components);
+        IALSSavableInterface::Execute_OnLoaded(Actor);
+        ExecuteComponentCallbacks(Components, EALSComponentCallback::ELoaded);
+    } else {
+        DeserializeActor(Actor, Record);
     }
+
     if (!bLoadTransform) {
         Actor->SetActorTransform(oldTrans);
     }
@@ -146,10 +244,19 @@ void UALSFunctionLibrary::FullDeserializeActor(AActor* Actor, const FALSActorDat
 
 void UALSFunctionLibrary::DeserializeActorComponents(AActor* Actor, const FALSActorData& ActorRecord)
 {
-    TArray<UActorComponent*> Components = IALSSavableInterface::Execute_GetComponentsToSave(Actor);
+    DeserializeComponents(IALSSavableInterface::Execute_GetComponentsToSave(Actor), ActorRecord);
+}
+
+void UALSFunctionLibrary::DeserializeComponents(const TArray<UActorComponent*>& Components, const FALSActorData& ActorRecord)
+{
+    int32 recordCursor = 0;
+    const AActor* Owner = nullptr;
     for (auto* Component : Components) {
+        if (!Component) {
+            continue;
+        }
 
-        const FALSComponentData* Record = ActorRecord.GetComponentData(Component);
+        const FALSComponentData* Record = ActorRecord.FindNextComponentData(Component, recordCursor);
 
         if (!Record) {
             continue;
@@ -163,25 +270,31 @@ void UALSFunctionLibrary::DeserializeActorComponents(AActor* Actor, const FALSAc
         FMemoryReader MemoryReader(Record->Data, true);
         FALSSaveGameArchive Archive(MemoryReader, false);
         Component->Serialize(Archive);
+
+        if (Component->GetOwner() != Owner) {
+            Owner = Component->GetOwner();
+            MarkLoadedOwnerDirty(Owner);
+        }
     }
 }
 
 FALSActorData UALSFunctionLibrary::SerializeActor(AActor* actor)
 {
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    FALSActorData Record = { actor };
+
     if (UKismetSystemLibrary::DoesImplementInterface(actor, UALSSavableInterface::StaticClass())) {
+        const TArray<UActorComponent*> Components = IALSSavableInterface::Execute_GetComponentsToSave(actor);
         IALSSavableInterface::Execute_OnSaved(actor);
-        UALSFunctionLibrary::ExecuteFunctionsOnSavableComponents(actor, saveSettings->GetOnComponentSavedFunctionName());
+        ExecuteComponentCallbacks(Components, EALSComponentCallback::ESaved);
+        SerializeComponents(Components, Record);
+    } else {
+        UALSFunctionLibrary::SerializeComponents(actor, Record);
     }
 
-    FALSActorData Record = { actor };
-
     Record.bHiddenInGame = actor->IsHidden();
     Record.Transform = actor->GetTransform();
     Record.Tags = actor->Tags;
 
-    UALSFunctionLibrary::SerializeComponents(actor, Record);
-
     FMemoryWriter MemoryWriter(Record.Data, true);
     FALSSaveGameArchive Archive(MemoryWriter, false);
     actor->Serialize(Archive);
@@ -191,8 +304,15 @@ FALSActorData UALSFunctionLibrary::SerializeActor(AActor* actor)
 
 void UALSFunctionLibrary::SerializeComponents(const AActor* Actor, FALSActorData& ActorRecord)
 {
-    TArray<UActorComponent*> Components = IALSSavableInterface::Execute_GetComponentsToSave(Actor);
+    SerializeComponents(IALSSavableInterface::Execute_GetComponentsToSave(Actor), ActorRecord);
+}
+
+void UALSFunctionLibrary::SerializeComponents(const TArray<UActorComponent*>& Components, FALSActorData& ActorRecord)
+{
     for (auto* Component : Components) {
+        if (!Component) {
+            continue;
+        }
         FALSComponentData ComponentRecord;
         ComponentRecord.alsName = Component->GetFName();
         ComponentRecord.Class = Component->GetClass();
@@ -17,11 +17,22 @@ UALSLoadAndSaveComponent::UALSLoadAndSaveComponent()
 void UALSLoadAndSaveComponent::BeginPlay()
 {
     Super::BeginPlay();
+    if (UALSLoadAndSaveSubsystem* saveSubsystem = GetSaveSubsystem()) {
+        saveSubsystem->RegisterSaveComponent(this);
+    }
     if (bAutoReload && !bAlreadyLoaded) {
         LoadActor();
     }
 }
 
+void UALSLoadAndSaveComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UALSLoadAndSaveSubsystem* saveSubsystem = GetSaveSubsystem()) {
+        saveSubsystem->UnregisterSaveComponent(this);
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
 void UALSLoadAndSaveComponent::SaveActor()
 {
     if (GetSaveSubsystem()->SaveActor(GetOwner())) {
@@ -38,6 +49,26 @@ void UALSLoadAndSaveComponent::LoadActor()
     }
 }
 
+bool UALSLoadAndSaveComponent::IsDirty() const
+{
+    if (!bTrackDirtyState || bDirty) {
+        return true;
+    }
+
+    // Movement is the most common change and does not go through MarkDirty
+    const AActor* owner = GetOwner();
+    return !owner || !owner->GetActorTransform().Equals(lastSavedTransform);
+}
+
+void UALSLoadAndSaveComponent::ClearDirty(const FString& slotName)
+{
+    bDirty = false;
+    lastSavedSlot = slotName;
+    if (const AActor* owner = GetOwner()) {
+        lastSavedTransform = owner->GetActorTransform();
+    }
+}
+
 void UALSLoadAndSaveComponent::DispatchLoaded()
 {
     bAlreadyLoaded = true;
@@ -46,5 +77,6 @@ void UALSLoadAndSaveComponent::DispatchLoaded()
 
 UALSLoadAndSaveSubsystem* UALSLoadAndSaveComponent::GetSaveSubsystem() const
 {
-    return UGameplayStatics::GetGameInstance(this)->GetSubsystem<UALSLoadAndSaveSubsystem>();
+    const UGameInstance* gameInstance = UGameplayStatics::GetGameInstance(this);
+    return gameInstance ? gameInstance->GetSubsystem<UALSLoadAndSaveSubsystem>() : nullptr;
 }
@@ -3,22 +3,53 @@
 #include "ALSLoadAndSaveSubsystem.h"
 #include "ALSFunctionLibrary.h"
 #include "ALSLoadAndSaveComponent.h"
+#include "ALSSaveContainer.h"
 #include "ALSSaveGameSettings.h"
 #include "ALSSaveInfo.h"
+#include "ALSStats.h"
 #include "Engine/GameInstance.h"
+#include "HAL/FileManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <Async/Async.h>
 #include <GameFramework/Pawn.h>
 #include <Serialization/MemoryReader.h>
 #include <Serialization/MemoryWriter.h>
 
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save Latency (ms)"), STAT_ALSSaveLatency, STATGROUP_ALS);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save Max Hitch (ms)"), STAT_ALSSaveMaxHitch, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Last Save Snapshot Frames"), STAT_ALSSaveSnapshotFrames, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Last Save Actors"), STAT_ALSSaveActors, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Last Save Reused Actors"), STAT_ALSSaveReusedActors, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Load Spawn Slice"), STAT_ALSLoadSpawnSlice, STATGROUP_ALS);
+
 void UALSLoadAndSaveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UALSLoadAndSaveSubsystem::HandleLoadingFinished);
+
+    // Slot queries are answered from memory once the index is loaded
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    FAsyncLoadGameFromSlotDelegate loadedDelegate;
+    loadedDelegate.BindUObject(this, &UALSLoadAndSaveSubsystem::HandleSaveIndexLoaded);
+    UGameplayStatics::AsyncLoadGameFromSlot(saveSettings->GetSaveMetadataName(), 0, loadedDelegate);
 }
 
 void UALSLoadAndSaveSubsystem::Deinitialize()
 {
     FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+    if (saveTickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(saveTickerHandle);
+        saveTickerHandle.Reset();
+    }
+    saveSnapshot.Reset();
+    CancelThumbnailCapture();
+    if (loadTickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(loadTickerHandle);
+        loadTickerHandle.Reset();
+    }
+    pendingLoad.Reset();
+    pendingThumbnails.Reset();
 }
 
 void UALSLoadAndSaveSubsystem::SaveGameWorld(const FString& slotName, const FOnSaveFinished& saveCallback,
@@ -29,11 +60,152 @@ void UALSLoadAndSaveSubsystem::SaveGameWorld(const FString& slotName, const FOnS
         UE_LOG(LogTemp, Warning, TEXT("You are already loading or saving!"));
         return;
     }
+    currentSavegame = LoadOrCreateSaveGame(slotName);
+    if (currentSavegame) {
+        // Clean actors reuse their records of the current level
+        currentSavegame->PrefetchLevel(UGameplayStatics::GetCurrentLevelName(GetWorld(), true));
+    }
+    StartSave(slotName, saveCallback, bSaveLocalPlayer, bSaveScreenshot, slotDescription, false);
+}
+
+void UALSLoadAndSaveSubsystem::AutoSaveGameWorld(const FOnSaveFinished& saveCallback, const bool bSaveLocalPlayer /*= true*/)
+{
+    if (systemState != ELoadingState::EIdle) {
+        saveCallback.ExecuteIfBound(false);
+        UE_LOG(LogTemp, Warning, TEXT("You are already loading or saving!"));
+        return;
+    }
+
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    const FString slotName = currentSaveSlot.IsEmpty() ? GetDefaultSaveName() : currentSaveSlot;
+    const FString mapName = UGameplayStatics::GetCurrentLevelName(GetWorld(), true);
+
+    FALSSaveMetadata slotMetadata;
+    const FString slotDescription = TryGetSaveMetadata(slotName, slotMetadata) ? slotMetadata.SaveDescription : FString();
+
+    // Deltas are only valid on top of the container the current save game is in sync with. SavePlayer and
+    // SaveLocalPlayer write the slot through their own save game, the full save then reloads it first
+    FALSSaveTable diskTable;
+    const bool bCanAppend = saveSettings->GetUseAutosaveJournal() && currentSavegame
+        && currentSavegame->GetContainerPath() == FALSSaveContainer::GetSlotPath(slotName)
+        && FALSSaveContainer::ReadTable(slotName, diskTable)
+        && diskTable.Generation == currentSavegame->GetContainerGeneration()
+        && currentSavegame->GetJournalEntries() < saveSettings->GetAutosaveJournalMaxEntries()
+        && (!currentSavegame->HasLevel(mapName) || currentSavegame->PrefetchLevel(mapName));
+
+    if (!bCanAppend) {
+        // Compacts the journal into the slot
+        SaveGameWorld(slotName, saveCallback, bSaveLocalPlayer, false, slotDescription);
+        return;
+    }
+    StartSave(slotName, saveCallback, bSaveLocalPlayer, false, slotDescription, true);
+}
+
+void UALSLoadAndSaveSubsystem::StartSave(const FString& slotName, const FOnSaveFinished& saveCallback, const bool bSaveLocalPlayer,
+    const bool bSaveScreenshot, const FString& slotDescription, const bool bDelta)
+{
     currentSaveSlot = slotName;
     onSaveFinishedInternal = saveCallback;
-    currentSavegame = LoadOrCreateSaveGame(slotName);
     systemState = ELoadingState::ESaving;
-    (new FAutoDeleteAsyncTask<FSaveWorldTask>(slotName, GetWorld(), bSaveLocalPlayer, bSaveScreenshot, slotDescription))->StartBackgroundTask();
+    pendingSlotDescription = slotDescription;
+    bSnapshotCaptured = false;
+
+    saveStartTime = FPlatformTime::Seconds();
+    saveMaxSliceTime = 0.0;
+    saveSnapshotFrames = 0;
+
+    // Actors are serialized on the game thread, the worker only builds and writes the save
+    saveSnapshot = MakeUnique<FALSWorldSnapshot>(GetWorld(), slotName, bSaveLocalPlayer, currentSavegame, bDelta);
+
+    // Rendered from the same frame as the first slice, read back while the snapshot is captured
+    CancelThumbnailCapture();
+    if (bSaveScreenshot && !bDelta) {
+        const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+        thumbnailCapture = MakeShared<FALSThumbnailCapture, ESPMode::ThreadSafe>(saveSettings->GetThumbnailWidth(), saveSettings->GetThumbnailHeight());
+        if (!thumbnailCapture->Start(GetWorld())) {
+            thumbnailCapture.Reset();
+        }
+    }
+    saveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UALSLoadAndSaveSubsystem::TickSaveSnapshot));
+}
+
+bool UALSLoadAndSaveSubsystem::TickSaveSnapshot(float deltaTime)
+{
+    if (!saveSnapshot) {
+        saveTickerHandle.Reset();
+        return false;
+    }
+
+    if (!bSnapshotCaptured) {
+        const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+        const double sliceStart = FPlatformTime::Seconds();
+        bSnapshotCaptured = saveSnapshot->CaptureSlice(saveSettings->GetSnapshotBudgetMs() / 1000.0);
+        saveMaxSliceTime = FMath::Max(saveMaxSliceTime, FPlatformTime::Seconds() - sliceStart);
+        saveSnapshotFrames++;
+
+        if (!bSnapshotCaptured) {
+            return true;
+        }
+    }
+
+    // The readback usually takes a couple of frames, the write waits for it
+    if (thumbnailCapture && !thumbnailCapture->Tick()) {
+        return true;
+    }
+
+    saveTickerHandle.Reset();
+    StartSaveWrite();
+    return false;
+}
+
+void UALSLoadAndSaveSubsystem::StartSaveWrite()
+{
+    const TUniquePtr<FALSWorldSnapshot> snapshot = MoveTemp(saveSnapshot);
+
+    // Empty if the capture failed or timed out
+    TArray<uint8> thumbnailData;
+    if (thumbnailCapture && thumbnailCapture->IsComplete()) {
+        thumbnailData = MoveTemp(thumbnailCapture->GetEncodedData());
+    }
+    CancelThumbnailCapture();
+
+    savedComponents = MoveTemp(snapshot->GetClearedComponents());
+    UWorld* world = GetWorld();
+    if (!snapshot->IsWorldValid() || !world || !currentSavegame) {
+        FinishSaveWork(false);
+        return;
+    }
+
+    UALSSaveInfo* saveInfo = LoadOrCreateSaveInfo();
+    if (!saveInfo) {
+        FinishSaveWork(false);
+        return;
+    }
+
+    FALSSaveSnapshot& snapshotData = snapshot->GetSnapshot();
+    FALSSaveMetadata saveMetaData;
+    saveMetaData.MapToLoad = snapshotData.mapName;
+    saveMetaData.Data = FDateTime::Now();
+    saveMetaData.SaveName = snapshotData.saveName;
+    saveMetaData.SaveDescription = pendingSlotDescription;
+    saveInfo->AddSlot(saveMetaData);
+    currentSavegame->SetSlotMetadata(saveMetaData);
+
+    snapshotData.extraActors = MoveTemp(ExtraActors);
+    CleanExtraActors();
+
+    SET_DWORD_STAT(STAT_ALSSaveActors, snapshot->GetNumCapturedActors());
+    SET_DWORD_STAT(STAT_ALSSaveReusedActors, snapshot->GetNumReusedActors());
+    SET_DWORD_STAT(STAT_ALSSaveSnapshotFrames, saveSnapshotFrames);
+    SET_FLOAT_STAT(STAT_ALSSaveMaxHitch, saveMaxSliceTime * 1000.0);
+
+    currentSavegame->OnSaved();
+
+    if (thumbnailData.Num() > 0) {
+        currentSavegame->SetThumbnail(MoveTemp(thumbnailData));
+    }
+
+    (new FAutoDeleteAsyncTask<FSaveWorldTask>(MoveTemp(snapshotData), world, currentSavegame))->StartBackgroundTask();
 }
 
 void UALSLoadAndSaveSubsystem::SaveGameWorldInCurrentSlot(const FOnSaveFinished& saveCallback, const bool bSaveLocalPlayer /*= true*/,
@@ -91,8 +263,9 @@ bool UALSLoadAndSaveSubsystem::SaveLocalPlayer(const FString& slotName)
 
     FALSPlayerData playerData(pcData, pawnData);
     saveGame->StoreLocalPlayer(playerData);
-    UGameplayStatics::SaveGameToSlot(saveGame, slotName, 0);
-    UGameplayStatics::SaveGameToSlot(saveInfo, saveSettings->GetSaveMetadataName(), 0);
+    saveGame->SetSlotMetadata(saveMetaData);
+    FALSSaveContainer::SaveGameToSlot(saveGame, slotName);
+    WriteSaveIndex();
     currentSaveSlot = slotName;
     return true;
 }
@@ -171,7 +344,12 @@ bool UALSLoadAndSaveSubsystem::SavePlayer(const FString& slotName, const FString
     CreateOrUpdateSlotInfo(slotName);
     currentSaveSlot = slotName;
 
-    return UGameplayStatics::SaveGameToSlot(saveGame, slotName, 0);
+    FALSSaveMetadata saveMetaData;
+    if (TryGetSaveMetadata(slotName, saveMetaData)) {
+        saveGame->SetSlotMetadata(saveMetaData);
+    }
+
+    return FALSSaveContainer::SaveGameToSlot(saveGame, slotName);
 }
 
 bool UALSLoadAndSaveSubsystem::CreateOrUpdateSlotInfo(const FString& slotName)
@@ -185,11 +363,7 @@ bool UALSLoadAndSaveSubsystem::CreateOrUpdateSlotInfo(const FString& slotName)
     saveMetaData.SaveName = slotName;
 
     saveInfo->AddSlot(saveMetaData);
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    if (!saveSettings) {
-        return false;
-    }
-    return UGameplayStatics::SaveGameToSlot(saveInfo, saveSettings->GetSaveMetadataName(), 0);
+    return WriteSaveIndex();
 }
 
 bool UALSLoadAndSaveSubsystem::RemoveSlotInfo(const FString& slotName)
@@ -200,11 +374,15 @@ bool UALSLoadAndSaveSubsystem::RemoveSlotInfo(const FString& slotName)
     }
 
     saveInfo->DeleteSlot(slotName);
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    if (!saveSettings) {
-        return false;
-    }
-    return UGameplayStatics::SaveGameToSlot(saveInfo, saveSettings->GetSaveMetadataName(), 0);
+    return WriteSaveIndex();
+}
+
+bool UALSLoadAndSaveSubsystem::DeleteSaveGame(const FString& slotName)
+{
+    InvalidateThumbnail(slotName);
+    const bool bDeleted = FALSSaveContainer::DeleteSlot(slotName);
+    RemoveSlotInfo(slotName);
+    return bDeleted;
 }
 
 bool UALSLoadAndSaveSubsystem::LoadPlayer(const FString& slotName, const FString& playerID, APlayerController* playerToLoad, bool bReloadTransform)
@@ -267,7 +445,7 @@ bool UALSLoadAndSaveSubsystem::LoadTraveledPlayer()
     const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
     const FString tempSlot = saveSettings->GetTravelSaveName();
     if (LoadLocalPlayer(tempSlot, false)) {
-        UGameplayStatics::DeleteGameInSlot(tempSlot, 0);
+        FALSSaveContainer::DeleteSlot(tempSlot);
         RemoveSlotInfo(tempSlot);
         SetLoadType(ELoadType::EDontReload);
         return true;
@@ -277,8 +455,7 @@ bool UALSLoadAndSaveSubsystem::LoadTraveledPlayer()
 
 bool UALSLoadAndSaveSubsystem::TryGetSaveMetadata(const FString& slotName, FALSSaveMetadata& outSaveMetadata) const
 {
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    const UALSSaveInfo* saveMetadata = Cast<UALSSaveInfo>(UGameplayStatics::LoadGameFromSlot(saveSettings->GetSaveMetadataName(), 0));
+    const UALSSaveInfo* saveMetadata = GetSaveIndex();
 
     if (!saveMetadata) {
         return false;
@@ -289,8 +466,7 @@ bool UALSLoadAndSaveSubsystem::TryGetSaveMetadata(const FString& slotName, FALSS
 
 TArray<FALSSaveMetadata> UALSLoadAndSaveSubsystem::GetAllSaveGames() const
 {
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    const UALSSaveInfo* saveMetadata = Cast<UALSSaveInfo>(UGameplayStatics::LoadGameFromSlot(saveSettings->GetSaveMetadataName(), 0));
+    const UALSSaveInfo* saveMetadata = GetSaveIndex();
 
     if (saveMetadata) {
         return saveMetadata->GetSaveSlots();
@@ -301,12 +477,13 @@ TArray<FALSSaveMetadata> UALSLoadAndSaveSubsystem::GetAllSaveGames() const
 
 bool UALSLoadAndSaveSubsystem::HasAnySaveGame() const
 {
-    return GetAllSaveGames().Num() > 0;
+    return GetCurrentSlotNum() > 0;
 }
 
 int32 UALSLoadAndSaveSubsystem::GetCurrentSlotNum() const
 {
-    return GetAllSaveGames().Num();
+    const UALSSaveInfo* saveMetadata = GetSaveIndex();
+    return saveMetadata ? saveMetadata->GetNumSlots() : 0;
 }
 
 int32 UALSLoadAndSaveSubsystem::GetMaxSlotsNum() const
@@ -323,19 +500,108 @@ int32 UALSLoadAndSaveSubsystem::GetMaxSlotsNum() const
 
 bool UALSLoadAndSaveSubsystem::CanAddNewSlot() const
 {
-    return GetAllSaveGames().Num() < GetMaxSlotsNum();
+    return GetCurrentSlotNum() < GetMaxSlotsNum();
 }
 
 bool UALSLoadAndSaveSubsystem::IsSlotNameUnique(const FString& slotName) const
 {
-    return !GetAllSaveGames().Contains(slotName);
+    const UALSSaveInfo* saveMetadata = GetSaveIndex();
+    return !saveMetadata || !saveMetadata->HasSlot(slotName);
 }
 
 UTexture2D* UALSLoadAndSaveSubsystem::GetScreenshotForSave(const FString& saveName) const
 {
+    UTexture2D* const* cachedThumbnail = thumbnailCache.Find(saveName);
+    if (cachedThumbnail && *cachedThumbnail) {
+        return *cachedThumbnail;
+    }
     return UALSFunctionLibrary::GetScreenshotByName(saveName);
 }
 
+void UALSLoadAndSaveSubsystem::GetScreenshotForSaveAsync(const FString& saveName, const FOnThumbnailLoaded& callback)
+{
+    UTexture2D** cachedThumbnail = thumbnailCache.Find(saveName);
+    if (cachedThumbnail && *cachedThumbnail) {
+        CacheThumbnail(saveName, *cachedThumbnail);
+        callback.ExecuteIfBound(saveName, *cachedThumbnail);
+        return;
+    }
+
+    // Requests for a slot that is already being decoded wait for the same result
+    if (TArray<FOnThumbnailLoaded>* pendingCallbacks = pendingThumbnails.Find(saveName)) {
+        pendingCallbacks->Add(callback);
+        return;
+    }
+    pendingThumbnails.Add(saveName).Add(callback);
+
+    FALSThumbnailCodec::LoadModules();
+
+    TWeakObjectPtr<UALSLoadAndSaveSubsystem> weakThis(this);
+    const int32 cacheEpoch = thumbnailCacheEpoch;
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [weakThis, saveName, cacheEpoch]() {
+        TArray<uint8> pngData;
+        if (!FALSSaveContainer::ReadThumbnail(saveName, pngData)) {
+            // Screenshot taken by previous versions
+            FFileHelper::LoadFileToArray(pngData, *UALSFunctionLibrary::ConstructScreenshotPath(saveName), FILEREAD_Silent);
+        }
+
+        FALSThumbnailPixels pixels;
+        if (pngData.Num() > 0) {
+            FALSThumbnailCodec::DecodePNG(pngData, pixels);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [weakThis, saveName, cacheEpoch, pixels = MoveTemp(pixels)]() {
+            if (weakThis.IsValid()) {
+                weakThis->HandleThumbnailDecoded(saveName, pixels, cacheEpoch);
+            }
+        });
+    });
+}
+
+void UALSLoadAndSaveSubsystem::HandleThumbnailDecoded(const FString& saveName, const FALSThumbnailPixels& pixels, const int32 cacheEpoch)
+{
+    TArray<FOnThumbnailLoaded> callbacks;
+    pendingThumbnails.RemoveAndCopyValue(saveName, callbacks);
+
+    UTexture2D* thumbnail = FALSThumbnailCodec::CreateTexture(pixels);
+    if (thumbnail && cacheEpoch == thumbnailCacheEpoch) {
+        CacheThumbnail(saveName, thumbnail);
+    }
+
+    for (const FOnThumbnailLoaded& callback : callbacks) {
+        callback.ExecuteIfBound(saveName, thumbnail);
+    }
+}
+
+void UALSLoadAndSaveSubsystem::CacheThumbnail(const FString& saveName, UTexture2D* thumbnail)
+{
+    thumbnailCache.Add(saveName, thumbnail);
+    thumbnailUsage.Remove(saveName);
+    thumbnailUsage.Add(saveName);
+
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    const int32 cacheSize = FMath::Max(saveSettings->GetThumbnailCacheSize(), 1);
+    while (thumbnailUsage.Num() > cacheSize) {
+        thumbnailCache.Remove(thumbnailUsage[0]);
+        thumbnailUsage.RemoveAt(0);
+    }
+}
+
+void UALSLoadAndSaveSubsystem::InvalidateThumbnail(const FString& saveName)
+{
+    thumbnailCache.Remove(saveName);
+    thumbnailUsage.Remove(saveName);
+    thumbnailCacheEpoch++;
+}
+
+void UALSLoadAndSaveSubsystem::CancelThumbnailCapture()
+{
+    if (thumbnailCapture) {
+        thumbnailCapture->ReleaseObjects();
+        thumbnailCapture.Reset();
+    }
+}
+
 FString UALSLoadAndSaveSubsystem::GetDefaultSaveName() const
 {
     const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
@@ -344,10 +610,132 @@ FString UALSLoadAndSaveSubsystem::GetDefaultSaveName() const
 
 void UALSLoadAndSaveSubsystem::FinishSaveWork(const bool bSuccess)
 {
+    SET_FLOAT_STAT(STAT_ALSSaveLatency, (FPlatformTime::Seconds() - saveStartTime) * 1000.0);
+
+    // Written here rather than by the worker, so slots deleted or fixed during the save are kept
+    WriteSaveIndex();
+
+    if (bSuccess) {
+        InvalidateThumbnail(currentSaveSlot);
+    }
+
+    // Nothing was written, so their previous records are stale
+    if (!bSuccess) {
+        for (const TWeakObjectPtr<UALSLoadAndSaveComponent>& saveComp : savedComponents) {
+            if (saveComp.IsValid()) {
+                saveComp->MarkDirty();
+            }
+        }
+    }
+    savedComponents.Reset();
     onSaveFinishedInternal.ExecuteIfBound(bSuccess);
     systemState = ELoadingState::EIdle;
 }
 
+void UALSLoadAndSaveSubsystem::ApplyLoadResult(const TSharedPtr<FALSLoadResult>& result, const bool bSuccess)
+{
+    if (!bSuccess || !result) {
+        FinishLoadWork(false);
+        return;
+    }
+
+    for (const TWeakObjectPtr<AActor>& actor : result->toBeDestroyed) {
+        if (actor.IsValid()) {
+            actor->Destroy();
+        }
+    }
+
+    pendingLoad = result;
+    nextSpawn = 0;
+    if (TickLoadSpawn(0.f)) {
+        loadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UALSLoadAndSaveSubsystem::TickLoadSpawn));
+    }
+}
+
+bool UALSLoadAndSaveSubsystem::TickLoadSpawn(float deltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSLoadSpawnSlice);
+
+    UWorld* world = GetWorld();
+    const FALSLevelData* levelData = (pendingLoad && currentSavegame) ? currentSavegame->FindLoadedLevel(pendingLoad->levelName) : nullptr;
+    if (!world || !pendingLoad || (!levelData && pendingLoad->toBeSpawned.Num() > 0)) {
+        loadTickerHandle.Reset();
+        pendingLoad.Reset();
+        FinishLoadWork(false);
+        return false;
+    }
+
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    const double budgetSeconds = saveSettings->GetSpawnBudgetMs() / 1000.0;
+    const double sliceStart = FPlatformTime::Seconds();
+    const TArray<int32>& toBeSpawned = pendingLoad->toBeSpawned;
+
+    // At least one actor per slice, so that the load always moves forward
+    FActorSpawnParameters SpawnInfo {};
+    while (toBeSpawned.IsValidIndex(nextSpawn)) {
+        const int32 recordIndex = toBeSpawned[nextSpawn++];
+        if (levelData->GetActors().IsValidIndex(recordIndex)) {
+            const FALSActorData& Record = levelData->GetActors()[recordIndex];
+            AActor* spawnedActor = world->SpawnActor(Record.Class, &Record.Transform, SpawnInfo);
+            if (spawnedActor) {
+                UALSFunctionLibrary::DeserializeActor(spawnedActor, Record);
+
+                UALSFunctionLibrary::ExecuteFunctionsOnSavableActor(spawnedActor,
+                    saveSettings->GetOnComponentLoadedFunctionName());
+            }
+        }
+
+        if (budgetSeconds > 0.0 && FPlatformTime::Seconds() - sliceStart >= budgetSeconds) {
+            break;
+        }
+    }
+
+    OnLoadProgress.Broadcast(toBeSpawned.Num() > 0 ? float(nextSpawn) / toBeSpawned.Num() : 1.f);
+    if (toBeSpawned.IsValidIndex(nextSpawn)) {
+        return true;
+    }
+
+    loadTickerHandle.Reset();
+    CompleteLoad();
+    return false;
+}
+
+void UALSLoadAndSaveSubsystem::CompleteLoad()
+{
+    const TSharedPtr<FALSLoadResult> result = MoveTemp(pendingLoad);
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+
+    for (const TPair<TWeakObjectPtr<AActor>, FALSActorLoaded>& actorRec : result->loadedActors) {
+        AActor* actor = actorRec.Key.Get();
+        if (!actor) {
+            continue;
+        }
+        actor->SetActorTransform(actorRec.Value.transform);
+
+        UALSFunctionLibrary::ExecuteFunctionsOnSavableActor(actor,
+            saveSettings->GetOnComponentLoadedFunctionName());
+    }
+
+    for (const TWeakObjectPtr<UALSLoadAndSaveComponent>& comp : result->wpActors) {
+        if (comp.IsValid()) {
+            comp->DispatchLoaded();
+        }
+    }
+    FinishLoadWork(true);
+}
+
+void UALSLoadAndSaveSubsystem::RegisterSaveComponent(UALSLoadAndSaveComponent* saveComp)
+{
+    if (saveComp) {
+        saveComponents.Add(saveComp);
+    }
+}
+
+void UALSLoadAndSaveSubsystem::UnregisterSaveComponent(UALSLoadAndSaveComponent* saveComp)
+{
+    saveComponents.Remove(saveComp);
+}
+
 void UALSLoadAndSaveSubsystem::FinishLoadWork(const bool bSuccess)
 {
 
@@ -378,11 +766,29 @@ void UALSLoadAndSaveSubsystem::HandleLoadCompleted(const FString& SaveSlot, cons
         SetLoadType(ELoadType::EDontReload);
         return;
     }
-    (new FAsyncTask<FLoadWorldTask>(currentSaveSlot, GetWorld(), UGameplayStatics::GetCurrentLevelName(GetWorld()), true))->StartBackgroundTask();
+    // Only the level being entered is decompressed, on the game thread before the load task needs it
+    currentSavegame->PrefetchLevel(UGameplayStatics::GetCurrentLevelName(GetWorld()));
+    (new FAutoDeleteAsyncTask<FLoadWorldTask>(currentSaveSlot, GetWorld(), UGameplayStatics::GetCurrentLevelName(GetWorld()), true, saveComponents.Array()))->StartBackgroundTask();
 }
 
 void UALSLoadAndSaveSubsystem::AsyncLoadSaveGame(const FString& savegameName)
 {
+    if (FALSSaveContainer::DoesSlotExist(savegameName)) {
+        TWeakObjectPtr<UALSLoadAndSaveSubsystem> weakThis(this);
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [weakThis, savegameName]() {
+            TSharedRef<FALSSaveContainerContents> contents = MakeShared<FALSSaveContainerContents>();
+            const bool bRead = FALSSaveContainer::ReadContents(savegameName, *contents);
+
+            AsyncTask(ENamedThreads::GameThread, [weakThis, savegameName, contents, bRead]() {
+                if (UALSLoadAndSaveSubsystem* subsystem = weakThis.Get()) {
+                    USaveGame* loadedGame = bRead ? FALSSaveContainer::CreateSaveGame(*contents) : nullptr;
+                    subsystem->HandleLoadCompleted(savegameName, 0, loadedGame);
+                }
+            });
+        });
+        return;
+    }
+
     FAsyncLoadGameFromSlotDelegate LoadedDelegate;
     LoadedDelegate.BindUObject(this, &UALSLoadAndSaveSubsystem::HandleLoadCompleted);
 
@@ -409,7 +815,7 @@ void UALSLoadAndSaveSubsystem::DeserializeObject(UObject* settingsObject, const
 UALSSaveGame* UALSLoadAndSaveSubsystem::LoadOrCreateSaveGame(const FString& slotName)
 {
     const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    UALSSaveGame* saveGame = Cast<UALSSaveGame>(UGameplayStatics::LoadGameFromSlot(slotName, 0));
+    UALSSaveGame* saveGame = FALSSaveContainer::LoadGameFromSlot(slotName);
     if (saveGame) {
         return saveGame;
     }
@@ -419,11 +825,117 @@ UALSSaveGame* UALSLoadAndSaveSubsystem::LoadOrCreateSaveGame(const FString& slot
 
 UALSSaveInfo* UALSLoadAndSaveSubsystem::LoadOrCreateSaveInfo()
 {
+    if (saveIndex) {
+        return saveIndex;
+    }
+
+    // Needed before the async load completed
     const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    UALSSaveInfo* saveMetadata = Cast<UALSSaveInfo>(UGameplayStatics::LoadGameFromSlot(saveSettings->GetSaveMetadataName(), 0));
-    if (saveMetadata) {
-        return saveMetadata;
+    saveIndex = Cast<UALSSaveInfo>(UGameplayStatics::LoadGameFromSlot(saveSettings->GetSaveMetadataName(), 0));
+    if (!saveIndex) {
+        saveIndex = Cast<UALSSaveInfo>(UGameplayStatics::CreateSaveGameObject(UALSSaveInfo::StaticClass()));
     }
+    return saveIndex;
+}
 
-    return Cast<UALSSaveInfo>(UGameplayStatics::CreateSaveGameObject(UALSSaveInfo::StaticClass()));
+const UALSSaveInfo* UALSLoadAndSaveSubsystem::GetSaveIndex() const
+{
+    if (saveIndex) {
+        return saveIndex;
+    }
+
+    // Cached like any other early read, so later queries don't hit the disk again
+    return const_cast<UALSLoadAndSaveSubsystem*>(this)->LoadOrCreateSaveInfo();
+}
+
+bool UALSLoadAndSaveSubsystem::WriteSaveIndex()
+{
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    return saveIndex && UGameplayStatics::SaveGameToSlot(saveIndex, saveSettings->GetSaveMetadataName(), 0);
+}
+
+void UALSLoadAndSaveSubsystem::HandleSaveIndexLoaded(const FString& SaveSlot, const int32 UserIndex, USaveGame* LoadedSaveData)
+{
+    // An index loaded synchronously in the meantime may already hold newer slots
+    if (!saveIndex) {
+        saveIndex = Cast<UALSSaveInfo>(LoadedSaveData);
+    }
+    if (!saveIndex) {
+        saveIndex = Cast<UALSSaveInfo>(UGameplayStatics::CreateSaveGameObject(UALSSaveInfo::StaticClass()));
+    }
+    ValidateSaveIndex();
+}
+
+void UALSLoadAndSaveSubsystem::ValidateSaveIndex()
+{
+    TArray<FString> indexedSlots;
+    for (const FALSSaveMetadata& slot : saveIndex->GetSaveSlots()) {
+        indexedSlots.Add(slot.SaveName);
+    }
+
+    TWeakObjectPtr<UALSLoadAndSaveSubsystem> weakThis(this);
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [weakThis, indexedSlots]() {
+        TArray<FString> missingSlots;
+        for (const FString& slotName : indexedSlots) {
+            if (!FALSSaveContainer::DoesSlotExist(slotName) && !UGameplayStatics::DoesSaveGameExist(slotName, 0)) {
+                missingSlots.Add(slotName);
+            }
+        }
+
+        // Containers carry their own metadata, slots written by previous versions can't be recovered
+        TArray<FString> containerFiles;
+        IFileManager::Get().FindFiles(containerFiles, *FALSSaveContainer::GetSlotPath(TEXT("*")), true, false);
+        TArray<FALSSaveMetadata> unindexedSlots;
+        for (const FString& containerFile : containerFiles) {
+            const FString slotName = FPaths::GetBaseFilename(containerFile);
+            FALSSaveTable table;
+            if (indexedSlots.Contains(slotName) || !FALSSaveContainer::ReadTable(slotName, table)) {
+                continue;
+            }
+
+            FALSSaveMetadata& slotMetadata = unindexedSlots.Add_GetRef(table.Metadata);
+            slotMetadata.SaveName = slotName;
+            if (slotMetadata.MapToLoad.IsEmpty() && table.LevelChunks.Num() == 1) {
+                slotMetadata.MapToLoad = table.LevelChunks[0].Name;
+            }
+            if (slotMetadata.Data == FDateTime()) {
+                slotMetadata.Data = IFileManager::Get().GetTimeStamp(*FALSSaveContainer::GetSlotPath(slotName));
+            }
+            if (slotMetadata.MapToLoad.IsEmpty()) {
+                unindexedSlots.Pop();
+            }
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [weakThis, missingSlots, unindexedSlots]() {
+            if (UALSLoadAndSaveSubsystem* subsystem = weakThis.Get()) {
+                subsystem->ApplySaveIndexFixes(missingSlots, unindexedSlots);
+            }
+        });
+    });
+}
+
+void UALSLoadAndSaveSubsystem::ApplySaveIndexFixes(const TArray<FString>& missingSlots, const TArray<FALSSaveMetadata>& unindexedSlots)
+{
+    if (!saveIndex) {
+        return;
+    }
+
+    // Slots may have been saved or indexed while the check was running
+    bool bChanged = false;
+    for (const FString& slotName : missingSlots) {
+        if (!FALSSaveContainer::DoesSlotExist(slotName) && !UGameplayStatics::DoesSaveGameExist(slotName, 0)) {
+            bChanged |= saveIndex->DeleteSlot(slotName);
+        }
+    }
+    for (const FALSSaveMetadata& slotMetadata : unindexedSlots) {
+        if (!saveIndex->HasSlot(slotMetadata.SaveName)) {
+            saveIndex->AddSlot(slotMetadata);
+            bChanged = true;
+        }
+    }
+
+    if (bChanged) {
+        UE_LOG(LogTemp, Warning, TEXT("Save metadata index was out of date and has been rebuilt - UALSLoadAndSaveSubsystem"));
+        WriteSaveIndex();
+    }
 }
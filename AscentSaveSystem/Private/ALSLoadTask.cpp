@@ -7,16 +7,19 @@
 #include "ALSSaveGame.h"
 #include "ALSSaveGameSettings.h"
 #include "ALSSaveTypes.h"
+#include "ALSStats.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "ALSLoadAndSaveComponent.h"
-#include <UObject/UObjectIterator.h>
+
+DECLARE_CYCLE_STAT(TEXT("Load Restore Actors"), STAT_ALSLoadWork, STATGROUP_ALS);
 
 void FLoadWorldTask::DoWork()
 {
+    SCOPE_CYCLE_COUNTER(STAT_ALSLoadWork);
 
     loadedGame = UGameplayStatics::GetGameInstance(this->world)->GetSubsystem<UALSLoadAndSaveSubsystem>()->GetCurrentSaveGame();
 
@@ -25,38 +28,40 @@ void FLoadWorldTask::DoWork()
         return;
     }
 
-    ToBeDestroyed.Empty();
-    FALSLevelData toBeDeserialized;
-
-    if (loadedGame->TryGetLevelData(levelName, toBeDeserialized)) {
-        TArray<FALSActorData> actorsData = toBeDeserialized.GetActorsCopy();
-
-        ToBeSpawned = actorsData;
-        for (auto& actor : LoadableActors) {
-            FALSActorData* actorData = actorsData.FindByKey(actor);
-            if (actorData) {
-                DeserializeActor(actor, *actorData);
-                ToBeSpawned.Remove(*actorData);
+    // Prefetched by the subsystem on the game thread. Records are read in place, the level is not modified while loading
+    const FALSLevelData* levelData = loadedGame->FindLoadedLevel(levelName);
+    if (levelData) {
+        const TArray<FALSActorData>& actorsData = levelData->GetActors();
+        TBitArray<> restoredRecords(false, actorsData.Num());
+
+        for (AActor* actor : LoadableActors) {
+            const int32 recordIndex = levelData->FindActorRecordIndex(actor->GetFName());
+            if (recordIndex != INDEX_NONE) {
+                DeserializeActor(actor, actorsData[recordIndex]);
+                restoredRecords[recordIndex] = true;
             } else if (!UALSFunctionLibrary::IsSpecialActor(world, actor) && !IALSSavableInterface::Execute_ShouldBeIgnored(actor)) {
-                ToBeDestroyed.Add(actor);
+                result->toBeDestroyed.Add(actor);
             }
         }
+
+        for (int32 index = 0; index < actorsData.Num(); index++) {
+            if (!restoredRecords[index]) {
+                result->toBeSpawned.Add(index);
+            }
+        }
+
         if (bLoadAll) {
             ReloadPlayer();
         }
 
-       
-
-        for (TObjectIterator<UALSLoadAndSaveComponent> It; It; ++It) {
-            UALSLoadAndSaveComponent* Component = *It;
-            if (IsValid(Component) && IsValid(Component->GetOwner())) {
-                FALSActorData outData;
-                
-                if (loadedGame->TryGetStoredWPActor(Component->GetOwner(), outData)) {
-                    UALSFunctionLibrary::DeserializeActor(Component->GetOwner(), outData);
-                    wpActors.Add(Component);
+        for (const TWeakObjectPtr<UALSLoadAndSaveComponent>& component : LoadableComponents) {
+            AActor* owner = component.IsValid() ? component->GetOwner() : nullptr;
+            if (IsValid(owner)) {
+                const FALSActorData* outData = loadedGame->FindStoredWPActor(owner->GetFName());
+                if (outData) {
+                    UALSFunctionLibrary::DeserializeActor(owner, *outData);
+                    result->wpActors.Add(component);
                 }
-                //LoadActor(Component->GetOwner());
             }
         }
 
@@ -66,6 +71,7 @@ void FLoadWorldTask::DoWork()
     } else if (bLoadAll) {
         ReloadPlayer();
         FinishLoad(true);
+        return;
     }
 
     FinishLoad(false);
@@ -79,7 +85,7 @@ bool FLoadWorldTask::DeserializeActor(AActor* Actor, const FALSActorData& Record
 
     UALSFunctionLibrary::DeserializeActor(Actor, Record);
 
-    SuccessfullyLoadedActors.Add(Actor, FALSActorLoaded(Record.Transform));
+    result->loadedActors.Emplace(Actor, FALSActorLoaded(Record.Transform));
 
     return true;
 }
@@ -87,11 +93,11 @@ bool FLoadWorldTask::DeserializeActor(AActor* Actor, const FALSActorData& Record
 void FLoadWorldTask::FinishLoad(const bool bSuccess)
 {
     if (IsInGameThread()) {
-        UGameplayStatics::GetGameInstance(this->world)->GetSubsystem<UALSLoadAndSaveSubsystem>()->FinishLoadWork(bSuccess);
+        GFinishLoad(world, result, bSuccess);
     } else {
         FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
             FSimpleDelegateGraphTask::FDelegate::CreateStatic(
-                &GFinishLoad, world, ToBeSpawned, SuccessfullyLoadedActors, ToBeDestroyed, wpActors,
+                &GFinishLoad, world, result,
                 bSuccess),
             GetStatId(),
             nullptr, ENamedThreads::GameThread);
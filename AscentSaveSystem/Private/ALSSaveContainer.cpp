@@ -0,0 +1,527 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ALSSaveContainer.h"
+#include "ALSSaveGame.h"
+#include "ALSSaveGameSettings.h"
+#include "ALSSaveTypes.h"
+#include "ALSStats.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+DECLARE_CYCLE_STAT(TEXT("Save Container Write"), STAT_ALSContainerWrite, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Save Container Read"), STAT_ALSContainerRead, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Save Container Read Level"), STAT_ALSContainerReadLevel, STATGROUP_ALS);
+
+FArchive& operator<<(FArchive& Ar, FALSSaveChunk& Chunk)
+{
+    // Names are stored as strings, plain file archives can't serialize FNames
+    FString format = Chunk.Format.IsNone() ? FString() : Chunk.Format.ToString();
+    Ar << Chunk.Name;
+    Ar << Chunk.Offset;
+    Ar << Chunk.CompressedSize;
+    Ar << Chunk.UncompressedSize;
+    Ar << format;
+    Ar << Chunk.Checksum;
+    if (Ar.IsLoading()) {
+        Chunk.Format = format.IsEmpty() ? NAME_None : FName(*format);
+    }
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FALSSaveTable& Table)
+{
+    Ar << Table.SaveGameClass;
+    Ar << Table.GameChunk;
+    Ar << Table.LevelChunks;
+    return Ar;
+}
+
+static void SerializeMetadata(FArchive& Ar, FALSSaveMetadata& Metadata)
+{
+    Ar << Metadata.SaveName;
+    Ar << Metadata.MapToLoad;
+    Ar << Metadata.SaveDescription;
+    Ar << Metadata.Data;
+}
+
+static bool HasThumbnail(const FALSSaveChunk& Chunk)
+{
+    return Chunk.CompressedSize > 0;
+}
+
+FString FALSSaveContainer::GetSlotPath(const FString& slotName)
+{
+    return FPaths::ProjectSavedDir() / TEXT("SaveGames") / slotName + TEXT(".alss");
+}
+
+FString FALSSaveContainer::GetJournalPath(const FString& slotName)
+{
+    return FPaths::ProjectSavedDir() / TEXT("SaveGames") / slotName + TEXT(".alsj");
+}
+
+bool FALSSaveContainer::DoesSlotExist(const FString& slotName)
+{
+    return IFileManager::Get().FileExists(*GetSlotPath(slotName));
+}
+
+bool FALSSaveContainer::SaveGameToSlot(UALSSaveGame* saveGame, const FString& slotName)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSContainerWrite);
+
+    if (!saveGame) {
+        return false;
+    }
+
+    const FName format = GetCompressionFormat();
+
+    // Written next to the slot and moved over it once complete, so a failed save never corrupts the previous one
+    const FString path = GetSlotPath(slotName);
+    const FString tempPath = path + TEXT(".tmp");
+    TUniquePtr<FArchive> writer(IFileManager::Get().CreateFileWriter(*tempPath));
+    if (!writer) {
+        return false;
+    }
+
+    uint32 magic = Magic;
+    int32 version = Version;
+    int64 tableOffset = 0;
+    *writer << magic << version << tableOffset;
+
+    FALSSaveTable table;
+    table.SaveGameClass = saveGame->GetClass()->GetPathName();
+    table.Metadata = saveGame->GetSlotMetadata();
+    table.Metadata.SaveName = slotName;
+    table.Generation = FGuid::NewGuid();
+
+    {
+        TArray<uint8> data;
+        FMemoryWriter memoryWriter(data, true);
+        FALSSaveGameArchive archive(memoryWriter, false);
+
+        // Levels get their own chunks
+        TMap<FString, FALSLevelData> levels = MoveTemp(saveGame->Levels);
+        saveGame->Levels.Reset();
+        saveGame->Serialize(archive);
+        saveGame->Levels = MoveTemp(levels);
+
+        table.GameChunk.Name = slotName;
+        WriteChunk(*writer, data, format, table.GameChunk);
+    }
+
+    TUniquePtr<FArchive> reader;
+    if (!saveGame->containerPath.IsEmpty()) {
+        reader.Reset(IFileManager::Get().CreateFileReader(*saveGame->containerPath));
+    }
+
+    for (TPair<FString, FALSLevelData>& level : saveGame->Levels) {
+        // Levels read back but never changed keep their previous chunk
+        const FALSSaveChunk* previousChunk = saveGame->levelChunks.Find(level.Key);
+        if (reader && previousChunk && !saveGame->modifiedLevels.Contains(level.Key)) {
+            FALSSaveChunk copiedChunk;
+            if (CopyChunk(*reader, *writer, *previousChunk, copiedChunk)) {
+                table.LevelChunks.Add(copiedChunk);
+                continue;
+            }
+        }
+
+        TArray<uint8> data;
+        FMemoryWriter memoryWriter(data, true);
+        FALSSaveGameArchive archive(memoryWriter, false);
+        FALSLevelData::StaticStruct()->SerializeItem(archive, &level.Value, nullptr);
+
+        FALSSaveChunk& chunk = table.LevelChunks.AddDefaulted_GetRef();
+        chunk.Name = level.Key;
+        WriteChunk(*writer, data, format, chunk);
+    }
+
+    // Levels that were never requested are still compressed in the previous container, copy them as they are
+    if (saveGame->levelChunks.Num() > 0) {
+        for (const TPair<FString, FALSSaveChunk>& chunk : saveGame->levelChunks) {
+            if (saveGame->Levels.Contains(chunk.Key)) {
+                continue;
+            }
+            FALSSaveChunk copiedChunk;
+            if (reader && CopyChunk(*reader, *writer, chunk.Value, copiedChunk)) {
+                table.LevelChunks.Add(copiedChunk);
+                continue;
+            }
+
+            // The level only exists in the previous container, writing without it would lose it for good
+            UE_LOG(LogTemp, Error, TEXT("Unable to copy level %s from the previous save, the save is aborted - FALSSaveContainer"), *chunk.Key);
+            reader.Reset();
+            writer.Reset();
+            IFileManager::Get().Delete(*tempPath);
+            return false;
+        }
+    }
+
+    // PNG data doesn't shrink any further, the thumbnail is always stored as it is
+    if (saveGame->thumbnailData.Num() > 0) {
+        table.ThumbnailChunk.Name = TEXT("Thumbnail");
+        WriteChunk(*writer, saveGame->thumbnailData, NAME_None, table.ThumbnailChunk);
+    } else if (reader && HasThumbnail(saveGame->thumbnailChunk)) {
+        if (!CopyChunk(*reader, *writer, saveGame->thumbnailChunk, table.ThumbnailChunk)) {
+            UE_LOG(LogTemp, Warning, TEXT("Unable to copy the thumbnail of %s from the previous save - FALSSaveContainer"), *slotName);
+        }
+    }
+
+    reader.Reset();
+
+    tableOffset = writer->Tell();
+    *writer << table;
+    SerializeMetadata(*writer, table.Metadata);
+    *writer << table.ThumbnailChunk;
+    *writer << table.Generation;
+    writer->Seek(0);
+    *writer << magic << version << tableOffset;
+
+    const bool bWritten = writer->Close() && !writer->IsError();
+    writer.Reset();
+    if (!bWritten || !IFileManager::Get().Move(*path, *tempPath, true)) {
+        // The previous container and its journal are both left untouched
+        IFileManager::Get().Delete(*tempPath);
+        return false;
+    }
+
+    // Every delta is now part of the container. A journal that survives a crash here has the previous generation and is ignored
+    IFileManager::Get().Delete(*GetJournalPath(slotName), false, false, true);
+
+    saveGame->containerPath = path;
+    saveGame->levelChunks.Reset();
+    for (const FALSSaveChunk& chunk : table.LevelChunks) {
+        saveGame->levelChunks.Add(chunk.Name, chunk);
+    }
+    saveGame->modifiedLevels.Reset();
+    saveGame->journalEntries = 0;
+    saveGame->journalSize = 0;
+    saveGame->containerGeneration = table.Generation;
+    saveGame->thumbnailChunk = table.ThumbnailChunk;
+    saveGame->thumbnailData.Empty();
+
+    // The container replaces the slot written by previous versions
+    if (UGameplayStatics::DoesSaveGameExist(slotName, 0)) {
+        UGameplayStatics::DeleteGameInSlot(slotName, 0);
+    }
+    return true;
+}
+
+bool FALSSaveContainer::ReadContents(const FString& slotName, FALSSaveContainerContents& outContents)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSContainerRead);
+
+    outContents.Path = GetSlotPath(slotName);
+    TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*outContents.Path));
+    if (!reader || !ReadTable(*reader, outContents.Path, outContents.Table)) {
+        return false;
+    }
+
+    if (!ReadChunk(*reader, outContents.Table.GameChunk, outContents.GameData)) {
+        return false;
+    }
+
+    ReadJournal(slotName, outContents);
+    return true;
+}
+
+void FALSSaveContainer::ReadJournal(const FString& slotName, FALSSaveContainerContents& outContents)
+{
+    TUniquePtr<FArchive> journalReader(IFileManager::Get().CreateFileReader(*GetJournalPath(slotName)));
+    if (!journalReader) {
+        return;
+    }
+
+    // Journals of containers written before version 4 have no header
+    if (outContents.Table.Generation.IsValid()) {
+        uint32 magic = 0;
+        FGuid generation;
+        *journalReader << magic << generation;
+        if (journalReader->IsError() || magic != JournalMagic || generation != outContents.Table.Generation) {
+            UE_LOG(LogTemp, Warning, TEXT("Ignoring a journal of %s written for another version of the slot - FALSSaveContainer"), *slotName);
+            return;
+        }
+        outContents.JournalSize = journalReader->Tell();
+    }
+
+    while (!journalReader->AtEnd()) {
+        FALSSaveChunk entryChunk;
+        *journalReader << entryChunk;
+        entryChunk.Offset = journalReader->Tell();
+
+        // A torn entry can only be the last one, left by an interrupted delta save. It stays in the file until the next
+        // full save, as JournalSize no longer matches it the next delta save is written as a full save
+        TArray<uint8>& entryData = outContents.JournalEntries.AddDefaulted_GetRef();
+        if (journalReader->IsError() || !ReadChunk(*journalReader, entryChunk, entryData)) {
+            outContents.JournalEntries.Pop();
+            UE_LOG(LogTemp, Warning, TEXT("Discarding the incomplete tail of the journal of %s - FALSSaveContainer"), *slotName);
+            break;
+        }
+        outContents.JournalSize = journalReader->Tell();
+    }
+}
+
+bool FALSSaveContainer::ReadTable(const FString& slotName, FALSSaveTable& outTable)
+{
+    const FString path = GetSlotPath(slotName);
+    TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*path));
+    return reader && ReadTable(*reader, path, outTable);
+}
+
+bool FALSSaveContainer::ReadTable(FArchive& reader, const FString& path, FALSSaveTable& outTable)
+{
+    uint32 magic = 0;
+    int32 version = 0;
+    int64 tableOffset = 0;
+    reader << magic << version << tableOffset;
+    if (magic != Magic || version > Version || tableOffset <= 0 || tableOffset >= reader.TotalSize()) {
+        UE_LOG(LogTemp, Error, TEXT("%s is not a valid save container - FALSSaveContainer"), *path);
+        return false;
+    }
+
+    reader.Seek(tableOffset);
+    reader << outTable;
+    if (version >= 2) {
+        SerializeMetadata(reader, outTable.Metadata);
+    }
+    if (version >= 3) {
+        reader << outTable.ThumbnailChunk;
+    }
+    if (version >= 4) {
+        reader << outTable.Generation;
+    }
+    return !reader.IsError();
+}
+
+UALSSaveGame* FALSSaveContainer::CreateSaveGame(const FALSSaveContainerContents& contents)
+{
+    check(IsInGameThread());
+
+    UClass* saveClass = LoadObject<UClass>(nullptr, *contents.Table.SaveGameClass);
+    if (!saveClass || !saveClass->IsChildOf(UALSSaveGame::StaticClass())) {
+        saveClass = GetMutableDefault<UALSSaveGameSettings>()->GetSaveGameClass();
+    }
+    if (!saveClass) {
+        return nullptr;
+    }
+
+    UALSSaveGame* saveGame = NewObject<UALSSaveGame>(GetTransientPackage(), saveClass);
+    FMemoryReader memoryReader(contents.GameData, true);
+    FALSSaveGameArchive archive(memoryReader, false);
+    saveGame->Serialize(archive);
+
+    saveGame->containerPath = contents.Path;
+    saveGame->SetSlotMetadata(contents.Table.Metadata);
+    saveGame->thumbnailChunk = contents.Table.ThumbnailChunk;
+    for (const FALSSaveChunk& chunk : contents.Table.LevelChunks) {
+        saveGame->levelChunks.Add(chunk.Name, chunk);
+    }
+
+    for (const TArray<uint8>& entryData : contents.JournalEntries) {
+        FALSJournalEntry entry;
+        FMemoryReader entryReader(entryData, true);
+        FALSSaveGameArchive entryArchive(entryReader, false);
+        FALSJournalEntry::StaticStruct()->SerializeItem(entryArchive, &entry, nullptr);
+        saveGame->ApplyJournalEntry(MoveTemp(entry));
+    }
+    saveGame->journalEntries = contents.JournalEntries.Num();
+    saveGame->journalSize = contents.JournalSize;
+    saveGame->containerGeneration = contents.Table.Generation;
+    return saveGame;
+}
+
+UALSSaveGame* FALSSaveContainer::LoadGameFromSlot(const FString& slotName)
+{
+    if (DoesSlotExist(slotName)) {
+        FALSSaveContainerContents contents;
+        return ReadContents(slotName, contents) ? CreateSaveGame(contents) : nullptr;
+    }
+    return Cast<UALSSaveGame>(UGameplayStatics::LoadGameFromSlot(slotName, 0));
+}
+
+bool FALSSaveContainer::ReadLevel(const FString& path, const FALSSaveChunk& chunk, FALSLevelData& outLevel)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSContainerReadLevel);
+
+    TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*path));
+    TArray<uint8> data;
+    if (!reader || !ReadChunk(*reader, chunk, data)) {
+        return false;
+    }
+
+    FMemoryReader memoryReader(data, true);
+    FALSSaveGameArchive archive(memoryReader, false);
+    FALSLevelData::StaticStruct()->SerializeItem(archive, &outLevel, nullptr);
+    return !memoryReader.IsError();
+}
+
+bool FALSSaveContainer::ReadThumbnail(const FString& slotName, TArray<uint8>& outPng)
+{
+    const FString path = GetSlotPath(slotName);
+    TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*path));
+    FALSSaveTable table;
+    if (!reader || !ReadTable(*reader, path, table) || !HasThumbnail(table.ThumbnailChunk)) {
+        return false;
+    }
+    return ReadChunk(*reader, table.ThumbnailChunk, outPng);
+}
+
+bool FALSSaveContainer::DeleteSlot(const FString& slotName)
+{
+    bool bDeleted = false;
+    if (DoesSlotExist(slotName)) {
+        bDeleted = IFileManager::Get().Delete(*GetSlotPath(slotName));
+    }
+    if (UGameplayStatics::DoesSaveGameExist(slotName, 0)) {
+        bDeleted |= UGameplayStatics::DeleteGameInSlot(slotName, 0);
+    }
+    IFileManager::Get().Delete(*GetJournalPath(slotName), false, false, true);
+    return bDeleted;
+}
+
+bool FALSSaveContainer::AppendJournalEntry(UALSSaveGame* saveGame, const FString& slotName, const FALSJournalEntry& entry)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSContainerWrite);
+
+    // Containers without a generation are upgraded by a full save before they get a journal
+    if (!saveGame || !saveGame->containerGeneration.IsValid()) {
+        return false;
+    }
+
+    // The slot may have been written since through another save game object, its journal would then be ignored on load
+    FALSSaveTable diskTable;
+    if (!ReadTable(slotName, diskTable) || diskTable.Generation != saveGame->containerGeneration) {
+        UE_LOG(LogTemp, Warning, TEXT("%s was written by another save, writing a full save - FALSSaveContainer"), *slotName);
+        return false;
+    }
+
+    // Entries appended after a torn tail or to a journal of another generation would never be read back
+    const FString journalPath = GetJournalPath(slotName);
+    if (saveGame->journalSize > 0 && IFileManager::Get().FileSize(*journalPath) != saveGame->journalSize) {
+        UE_LOG(LogTemp, Warning, TEXT("The journal of %s does not end with its last entry, writing a full save - FALSSaveContainer"), *slotName);
+        return false;
+    }
+
+    TArray<uint8> data;
+    FMemoryWriter memoryWriter(data, true);
+    FALSSaveGameArchive archive(memoryWriter, false);
+    FALSJournalEntry::StaticStruct()->SerializeItem(archive, const_cast<FALSJournalEntry*>(&entry), nullptr);
+
+    FALSSaveChunk entryChunk;
+    TArray<uint8> payload;
+    entryChunk.Name = entry.LevelName;
+    CompressChunk(data, GetCompressionFormat(), entryChunk, payload);
+
+    TArray<uint8> record;
+    FMemoryWriter recordWriter(record);
+    if (saveGame->journalSize == 0) {
+        // First entry for this container, whatever journal is left on disk is replaced
+        uint32 magic = JournalMagic;
+        recordWriter << magic << saveGame->containerGeneration;
+    }
+    recordWriter << entryChunk;
+    recordWriter.Serialize(payload.GetData(), payload.Num());
+
+    TUniquePtr<FArchive> writer(IFileManager::Get().CreateFileWriter(*journalPath, saveGame->journalSize > 0 ? FILEWRITE_Append : FILEWRITE_None));
+    if (!writer) {
+        return false;
+    }
+    writer->Serialize(record.GetData(), record.Num());
+    if (!writer->Close() || writer->IsError()) {
+        return false;
+    }
+
+    saveGame->journalEntries++;
+    saveGame->journalSize += record.Num();
+    return true;
+}
+
+FName FALSSaveContainer::GetCompressionFormat()
+{
+    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
+    const FName format = saveSettings->GetSaveCompressionFormat();
+    if (!format.IsNone() && !FCompression::IsFormatValid(format)) {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid save compression format %s, chunks will be stored uncompressed - FALSSaveContainer"), *format.ToString());
+        return NAME_None;
+    }
+    return format;
+}
+
+void FALSSaveContainer::CompressChunk(const TArray<uint8>& data, const FName& format, FALSSaveChunk& outChunk, TArray<uint8>& outPayload)
+{
+    outChunk.UncompressedSize = data.Num();
+    outChunk.Format = NAME_None;
+
+    if (!format.IsNone() && data.Num() > 0) {
+        int32 compressedSize = FCompression::CompressMemoryBound(format, data.Num());
+        outPayload.SetNumUninitialized(compressedSize);
+        // Chunks that don't shrink are stored as they are
+        if (FCompression::CompressMemory(format, outPayload.GetData(), compressedSize, data.GetData(), data.Num()) && compressedSize < data.Num()) {
+            outPayload.SetNum(compressedSize);
+            outChunk.Format = format;
+        }
+    }
+
+    if (outChunk.Format.IsNone()) {
+        outPayload = data;
+    }
+    outChunk.CompressedSize = outPayload.Num();
+    outChunk.Checksum = FCrc::MemCrc32(outPayload.GetData(), outPayload.Num());
+}
+
+void FALSSaveContainer::WriteChunk(FArchive& writer, const TArray<uint8>& data, const FName& format, FALSSaveChunk& outChunk)
+{
+    TArray<uint8> payload;
+    CompressChunk(data, format, outChunk, payload);
+    outChunk.Offset = writer.Tell();
+    writer.Serialize(payload.GetData(), payload.Num());
+}
+
+bool FALSSaveContainer::ReadChunk(FArchive& reader, const FALSSaveChunk& chunk, TArray<uint8>& outData)
+{
+    if (chunk.Offset < 0 || chunk.CompressedSize < 0 || chunk.Offset + chunk.CompressedSize > reader.TotalSize()) {
+        return false;
+    }
+
+    TArray<uint8> stored;
+    stored.SetNumUninitialized(chunk.CompressedSize);
+    reader.Seek(chunk.Offset);
+    reader.Serialize(stored.GetData(), stored.Num());
+
+    if (reader.IsError() || FCrc::MemCrc32(stored.GetData(), stored.Num()) != chunk.Checksum) {
+        UE_LOG(LogTemp, Error, TEXT("Corrupted save chunk %s - FALSSaveContainer"), *chunk.Name);
+        return false;
+    }
+
+    if (chunk.Format.IsNone()) {
+        outData = MoveTemp(stored);
+        return true;
+    }
+
+    outData.SetNumUninitialized(chunk.UncompressedSize);
+    return FCompression::UncompressMemory(chunk.Format, outData.GetData(), outData.Num(), stored.GetData(), stored.Num());
+}
+
+bool FALSSaveContainer::CopyChunk(FArchive& reader, FArchive& writer, const FALSSaveChunk& chunk, FALSSaveChunk& outChunk)
+{
+    if (chunk.Offset < 0 || chunk.CompressedSize < 0 || chunk.Offset + chunk.CompressedSize > reader.TotalSize()) {
+        return false;
+    }
+
+    TArray<uint8> stored;
+    stored.SetNumUninitialized(chunk.CompressedSize);
+    reader.Seek(chunk.Offset);
+    reader.Serialize(stored.GetData(), stored.Num());
+    if (reader.IsError() || FCrc::MemCrc32(stored.GetData(), stored.Num()) != chunk.Checksum) {
+        return false;
+    }
+
+    outChunk = chunk;
+    outChunk.Offset = writer.Tell();
+    writer.Serialize(stored.GetData(), stored.Num());
+    return true;
+}
@@ -2,6 +2,7 @@
 
 
 #include "ALSSaveGame.h"
+#include "ALSSaveContainer.h"
 
 void UALSSaveGame::OnSaved_Implementation()
 {
@@ -12,3 +13,49 @@ void UALSSaveGame::OnLoaded_Implementation()
 {
 
 }
+
+bool UALSSaveGame::PrefetchLevel(const FString& levelName)
+{
+    if (Levels.Contains(levelName)) {
+        return true;
+    }
+
+    const FALSSaveChunk* chunk = levelChunks.Find(levelName);
+    if (!chunk) {
+        return false;
+    }
+
+    FALSLevelData levelData;
+    if (!FALSSaveContainer::ReadLevel(containerPath, *chunk, levelData)) {
+        return false;
+    }
+    Levels.Add(levelName, MoveTemp(levelData));
+    return true;
+}
+
+void UALSSaveGame::ApplyJournalEntry(FALSJournalEntry&& entry)
+{
+    // Levels saved for the first time by a delta start empty
+    if (!entry.LevelName.IsEmpty() && !HasLevel(entry.LevelName)) {
+        Levels.Add(entry.LevelName);
+    }
+
+    if (!entry.LevelName.IsEmpty() && PrefetchLevel(entry.LevelName)) {
+        FALSLevelData& levelData = Levels.FindChecked(entry.LevelName);
+        for (const FName& removedActor : entry.RemovedActors) {
+            levelData.RemoveActorRecord(removedActor);
+        }
+        for (FALSActorData& actorData : entry.Actors) {
+            levelData.UpdateActorRecord(MoveTemp(actorData));
+        }
+        modifiedLevels.Add(entry.LevelName);
+    }
+
+    for (const FALSActorData& extraActor : entry.ExtraActors) {
+        StoreWPActors(extraActor);
+    }
+
+    if (entry.bHasLocalPlayer) {
+        StoreLocalPlayer(entry.LocalPlayer);
+    }
+}
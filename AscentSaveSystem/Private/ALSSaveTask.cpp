@@ -2,12 +2,15 @@
 
 #include "ALSSaveTask.h"
 #include "ALSFunctionLibrary.h"
+#include "ALSLoadAndSaveComponent.h"
 #include "ALSLoadAndSaveSubsystem.h"
 #include "ALSSavableInterface.h"
+#include "ALSSaveContainer.h"
 #include "ALSSaveGame.h"
 #include "ALSSaveGameSettings.h"
 #include "ALSSaveInfo.h"
 #include "ALSSaveTypes.h"
+#include "ALSStats.h"
 #include "Engine/LevelStreaming.h"
 #include "GameFramework/Actor.h"
 #include "GameFramework/GameMode.h"
@@ -20,81 +23,178 @@
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include <Async/TaskGraphInterfaces.h>
 
-void FSaveWorldTask::DoWork()
+DECLARE_CYCLE_STAT(TEXT("Save Snapshot Slice"), STAT_ALSSaveSnapshotSlice, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Save Write"), STAT_ALSSaveWrite, STATGROUP_ALS);
+
+FALSWorldSnapshot::FALSWorldSnapshot(UWorld* inWorld, const FString& slotName, const bool saveLocalPlayer,
+    UALSSaveGame* inPreviousSave, const bool inDeltaOnly)
 {
-    if (!world) {
-        FinishSave(false);
-        return;
-    }
+    world = inWorld;
+    bSaveLocalPlayer = saveLocalPlayer;
+    previousSave = inPreviousSave;
+    bDeltaOnly = inDeltaOnly;
+    snapshot.saveName = slotName;
+    snapshot.bDelta = inDeltaOnly;
+
+    if (inWorld) {
+        snapshot.mapName = UGameplayStatics::GetCurrentLevelName(inWorld, true);
+
+        if (const FALSLevelData* previousLevel = FindPreviousLevel()) {
+            seenRecords.Init(false, previousLevel->GetActors().Num());
+        }
 
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    if (!saveSettings) {
-        FinishSave(false);
-        return;
+        TArray<AActor*> savableActors;
+        UGameplayStatics::GetAllActorsWithInterface(inWorld, UALSSavableInterface::StaticClass(), savableActors);
+        pendingActors.Reserve(savableActors.Num());
+        for (AActor* actor : savableActors) {
+            pendingActors.Add(actor);
+        }
+        snapshot.actors.Reserve(savableActors.Num());
     }
-    UALSLoadAndSaveSubsystem* saveSusbsystem = UGameplayStatics::GetGameInstance(world)->GetSubsystem<UALSLoadAndSaveSubsystem>();
+}
 
-    const TSubclassOf<UALSSaveGame> saveClass = saveSettings->GetSaveGameClass();
-    if (!saveClass) {
-        FinishSave(false);
-        return;
-    }
-    newSave = saveSusbsystem->GetCurrentSaveGame(); // Cast<UALSSaveGame>(UGameplayStatics::CreateSaveGameObject(saveClass));
+bool FALSWorldSnapshot::CaptureSlice(const double budgetSeconds)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSSaveSnapshotSlice);
 
-    FALSLevelData currentLevel;
+    UWorld* currentWorld = world.Get();
+    if (!currentWorld) {
+        return true;
+    }
 
-    for (const auto& actor : SavableActors) {
-        if (!actor) {
-            continue;
+    // At least one actor per slice, so that the snapshot always moves forward
+    const double sliceStart = FPlatformTime::Seconds();
+    while (pendingActors.IsValidIndex(nextActor)) {
+        AActor* actor = pendingActors[nextActor++].Get();
+        if (actor && UALSFunctionLibrary::ShouldSaveActor(actor) && !UALSFunctionLibrary::IsSpecialActor(currentWorld, actor)) {
+            CaptureActor(actor);
         }
-        if (!UALSFunctionLibrary::ShouldSaveActor(actor)) {
-            continue;
-        }
-        if (UALSFunctionLibrary::IsSpecialActor(world, actor)) {
-            continue;
+
+        if (FPlatformTime::Seconds() - sliceStart >= budgetSeconds) {
+            break;
         }
-        FALSActorData actorData = SerializeActor(actor);
-        currentLevel.AddActorRecord(actorData);
     }
-    UALSSaveInfo* saveInfo = saveSusbsystem->LoadOrCreateSaveInfo();
-    if (!saveInfo) {
-        FinishSave(false);
+
+    if (pendingActors.IsValidIndex(nextActor)) {
+        return false;
     }
 
-    FALSSaveMetadata saveMetaData;
-    saveMetaData.MapToLoad = UGameplayStatics::GetCurrentLevelName(world, true);
-    saveMetaData.Data = FDateTime::Now();
-    saveMetaData.SaveName = saveName;
-    saveMetaData.SaveDescription = slotDesc;
-    saveInfo->AddSlot(saveMetaData);
+    // Records left unseen belong to actors destroyed since the previous save
+    const FALSLevelData* previousLevel = FindPreviousLevel();
+    if (bDeltaOnly && previousLevel) {
+        const TArray<FALSActorData>& records = previousLevel->GetActors();
+        for (int32 index = 0; index < records.Num() && index < seenRecords.Num(); index++) {
+            if (!seenRecords[index]) {
+                snapshot.removedActors.Add(records[index].GetName());
+            }
+        }
+    }
 
-    newSave->AddLevel(saveMetaData.MapToLoad, currentLevel);
+    if (bSaveLocalPlayer) {
+        CaptureLocalPlayer();
+    }
+    return true;
+}
 
-    TArray<FALSActorData> outActors;
-    saveSusbsystem->GetExtraActors(outActors);
+void FALSWorldSnapshot::CaptureActor(AActor* actor)
+{
+    const FALSLevelData* previousLevel = FindPreviousLevel();
+    const int32 recordIndex = previousLevel ? previousLevel->FindActorRecordIndex(actor->GetFName()) : INDEX_NONE;
+    const FALSActorData* previousRecord = nullptr;
+    if (seenRecords.IsValidIndex(recordIndex)) {
+        seenRecords[recordIndex] = true;
+        previousRecord = &previousLevel->GetActors()[recordIndex];
+    }
 
-    for (const auto& extActor : outActors) {
-        newSave->StoreWPActors(extActor);
+    UALSLoadAndSaveComponent* saveComp = actor->FindComponentByClass<UALSLoadAndSaveComponent>();
+    const bool bTracked = saveComp && saveComp->ShouldTrackDirtyState();
+    if (bTracked && previousRecord && saveComp->IsSavedIn(snapshot.saveName)) {
+        reusedActors++;
+        if (!bDeltaOnly) {
+            snapshot.actors.Add(*previousRecord);
+        }
+        return;
     }
-    saveSusbsystem->CleanExtraActors();
-    StoreLocalPlayer();
 
-    newSave->OnSaved();
-    UGameplayStatics::SaveGameToSlot(newSave, saveName, 0);
+    FALSActorData record = UALSFunctionLibrary::SerializeActor(actor);
+    if (bTracked) {
+        saveComp->ClearDirty(snapshot.saveName);
+        clearedComponents.Add(saveComp);
+    }
 
-    if (bSaveScreenshot) {
-        UALSFunctionLibrary::TrySaveSceenshot(saveName, saveSettings->GetDefaultScreenshotWidth(), saveSettings->GetDefaultScreenshotHeight());
+    // Untracked actors are still serialized, but a delta only keeps them if something changed
+    if (bDeltaOnly && previousRecord && previousRecord->HasSameState(record)) {
+        reusedActors++;
+        return;
     }
-    UGameplayStatics::SaveGameToSlot(saveInfo, saveSettings->GetSaveMetadataName(), 0);
+    snapshot.actors.Add(MoveTemp(record));
+}
 
-    FinishSave(true);
+const FALSLevelData* FALSWorldSnapshot::FindPreviousLevel() const
+{
+    const UALSSaveGame* save = previousSave.Get();
+    return save ? save->FindLoadedLevel(snapshot.mapName) : nullptr;
+}
+
+void FALSWorldSnapshot::CaptureLocalPlayer()
+{
+    APlayerController* playerCont = UGameplayStatics::GetPlayerController(world.Get(), 0);
+    APawn* pawn = UGameplayStatics::GetPlayerPawn(world.Get(), 0);
+    if (UALSFunctionLibrary::ShouldSaveActor(playerCont) && UALSFunctionLibrary::ShouldSaveActor(pawn)) {
+        const FALSActorData pcData = UALSFunctionLibrary::SerializeActor(playerCont);
+        const FALSActorData pawnData = UALSFunctionLibrary::SerializeActor(pawn);
+        snapshot.localPlayer = FALSPlayerData(pcData, pawnData);
+        snapshot.bHasLocalPlayer = true;
+    } else {
+        UE_LOG(LogTemp, Error,
+            TEXT("Player Controller or Pawn does not implement savable interface! - FALSWorldSnapshot::CaptureLocalPlayer"));
+    }
 }
 
-FALSActorData FSaveWorldTask::SerializeActor(AActor* actor)
+void FSaveWorldTask::DoWork()
 {
-    FALSActorData outData = UALSFunctionLibrary::SerializeActor(actor);
-    SuccessfullySavedActors.Add(actor);
-    return outData;
+    SCOPE_CYCLE_COUNTER(STAT_ALSSaveWrite);
+
+    if (!newSave) {
+        FinishSave(false);
+        return;
+    }
+
+    if (snapshot.bDelta) {
+        FALSJournalEntry entry;
+        entry.LevelName = snapshot.mapName;
+        entry.Actors = MoveTemp(snapshot.actors);
+        entry.RemovedActors = MoveTemp(snapshot.removedActors);
+        entry.ExtraActors = MoveTemp(snapshot.extraActors);
+        entry.bHasLocalPlayer = snapshot.bHasLocalPlayer;
+        entry.LocalPlayer = snapshot.localPlayer;
+
+        const bool bAppended = FALSSaveContainer::AppendJournalEntry(newSave, snapshot.saveName, entry);
+        newSave->ApplyJournalEntry(MoveTemp(entry));
+
+        // A journal that can't be written is replaced by a full save
+        const bool bSaved = bAppended || FALSSaveContainer::SaveGameToSlot(newSave, snapshot.saveName);
+        FinishSave(bSaved);
+        return;
+    }
+
+    FALSLevelData currentLevel;
+    for (FALSActorData& actorData : snapshot.actors) {
+        currentLevel.AddActorRecord(MoveTemp(actorData));
+    }
+    snapshot.actors.Empty();
+    newSave->AddLevel(snapshot.mapName, MoveTemp(currentLevel));
+
+    for (const auto& extActor : snapshot.extraActors) {
+        newSave->StoreWPActors(extActor);
+    }
+
+    if (snapshot.bHasLocalPlayer) {
+        newSave->StoreLocalPlayer(snapshot.localPlayer);
+    }
+
+    const bool bSaved = FALSSaveContainer::SaveGameToSlot(newSave, snapshot.saveName);
+    FinishSave(bSaved);
 }
 
 void FSaveWorldTask::FinishSave(const bool bSuccess)
@@ -110,18 +210,3 @@ void FSaveWorldTask::FinishSave(const bool bSuccess)
             nullptr, ENamedThreads::GameThread);
     }
 }
-
-void FSaveWorldTask::StoreLocalPlayer()
-{
-    APlayerController* playerCont = UGameplayStatics::GetPlayerController(world, 0);
-    APawn* pawn = UGameplayStatics::GetPlayerPawn(world, 0);
-    if (UALSFunctionLibrary::ShouldSaveActor(playerCont) && UALSFunctionLibrary::ShouldSaveActor(pawn)) {
-        const FALSActorData pcData = SerializeActor(playerCont);
-        const FALSActorData pawnData = SerializeActor(pawn);
-        FALSPlayerData playerData(pcData, pawnData);
-        newSave->StoreLocalPlayer(playerData);
-    } else {
-        UE_LOG(LogTemp, Error,
-            TEXT("Player Controller or Pawn does not implement savable interface! - FSaveWorldTask::StoreLocalPlayer"));
-    }
-}
@@ -46,12 +46,63 @@ bool FALSActorData::Serialize(FArchive& Ar)
 	return true;
 }
 
+bool FALSActorData::HasSameState(const FALSActorData& Other) const
+{
+	if (Class != Other.Class || bHiddenInGame != Other.bHiddenInGame || Data != Other.Data || Tags != Other.Tags ||
+		!Transform.Equals(Other.Transform) || ComponentRecords.Num() != Other.ComponentRecords.Num()) {
+		return false;
+	}
+
+	for (int32 index = 0; index < ComponentRecords.Num(); index++) {
+		const FALSComponentData& component = ComponentRecords[index];
+		const FALSComponentData& otherComponent = Other.ComponentRecords[index];
+		if (component.alsName != otherComponent.alsName || component.Data != otherComponent.Data ||
+			!component.Transform.Equals(otherComponent.Transform)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 bool FALSLevelData::Serialize(FArchive& Ar)
 {
 	Super::Serialize(Ar);
 
 	Ar << Actors;
+	if (Ar.IsLoading()) {
+		RebuildActorIndex();
+	}
 
 	return true;
 }
 
+void FALSLevelData::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading()) {
+		RebuildActorIndex();
+	}
+}
+
+void FALSLevelData::RebuildActorIndex()
+{
+	ActorIndex.Reset();
+	ActorIndex.Reserve(Actors.Num());
+	for (int32 index = 0; index < Actors.Num(); index++) {
+		ActorIndex.Add(Actors[index].GetName(), index);
+	}
+}
+
+void FALSLevelData::RemoveActorRecord(const FName& actorName)
+{
+	int32 index = INDEX_NONE;
+	if (!ActorIndex.RemoveAndCopyValue(actorName, index)) {
+		return;
+	}
+
+	Actors.RemoveAtSwap(index);
+	// The last record took the place of the removed one
+	if (Actors.IsValidIndex(index)) {
+		ActorIndex.Add(Actors[index].GetName(), index);
+	}
+}
+
@@ -0,0 +1,232 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ALSThumbnail.h"
+#include "ALSStats.h"
+#include "Async/Async.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Modules/ModuleManager.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+
+DECLARE_CYCLE_STAT(TEXT("Thumbnail Capture"), STAT_ALSThumbnailCapture, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Thumbnail Encode"), STAT_ALSThumbnailEncode, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Thumbnail Decode"), STAT_ALSThumbnailDecode, STATGROUP_ALS);
+
+// The save is not held back any longer than this by a readback that never completes
+static constexpr double ThumbnailTimeoutSeconds = 2.0;
+
+static IImageWrapperModule& GetImageWrapperModule()
+{
+    // Modules can only be loaded on the game thread, workers rely on it being loaded already
+    if (IsInGameThread()) {
+        return FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+    }
+    return FModuleManager::GetModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+}
+
+FALSThumbnailCapture::FALSThumbnailCapture(const int32 inWidth, const int32 inHeight)
+    : width(FMath::Max(inWidth, 1))
+    , height(FMath::Max(inHeight, 1))
+{
+}
+
+bool FALSThumbnailCapture::CanCapture()
+{
+    return FApp::CanEverRender() && !GUsingNullRHI;
+}
+
+bool FALSThumbnailCapture::Start(UWorld* world)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSThumbnailCapture);
+    check(IsInGameThread());
+
+    APlayerCameraManager* cameraManager = world ? UGameplayStatics::GetPlayerCameraManager(world, 0) : nullptr;
+    if (!CanCapture() || !cameraManager) {
+        bComplete = true;
+        return false;
+    }
+
+    FALSThumbnailCodec::LoadModules();
+
+    renderTarget.Reset(NewObject<UTextureRenderTarget2D>(GetTransientPackage()));
+    renderTarget->ClearColor = FLinearColor::Black;
+    renderTarget->InitCustomFormat(width, height, PF_B8G8R8A8, false);
+
+    captureComponent.Reset(NewObject<USceneCaptureComponent2D>(GetTransientPackage()));
+    captureComponent->bCaptureEveryFrame = false;
+    captureComponent->bCaptureOnMovement = false;
+    captureComponent->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
+    captureComponent->TextureTarget = renderTarget.Get();
+    captureComponent->FOVAngle = cameraManager->GetFOVAngle();
+    captureComponent->SetWorldLocationAndRotation(cameraManager->GetCameraLocation(), cameraManager->GetCameraRotation());
+    captureComponent->RegisterComponentWithWorld(world);
+    captureComponent->CaptureScene();
+
+    readback = MakeShared<FRHIGPUTextureReadback, ESPMode::ThreadSafe>(TEXT("ALSThumbnailReadback"));
+    TSharedPtr<FRHIGPUTextureReadback, ESPMode::ThreadSafe> readbackRef = readback;
+    FTextureRenderTargetResource* targetResource = renderTarget->GameThread_GetRenderTargetResource();
+    ENQUEUE_RENDER_COMMAND(ALSThumbnailReadback)
+    ([readbackRef, targetResource](FRHICommandListImmediate& RHICmdList) {
+        readbackRef->EnqueueCopy(RHICmdList, targetResource->GetRenderTargetTexture());
+    });
+
+    startTime = FPlatformTime::Seconds();
+    return true;
+}
+
+bool FALSThumbnailCapture::Tick()
+{
+    check(IsInGameThread());
+
+    // The capture was rendered when the copy was enqueued, the component is no longer needed
+    if (captureComponent) {
+        captureComponent->UnregisterComponent();
+        captureComponent.Reset();
+    }
+
+    if (bComplete) {
+        ReleaseObjects();
+        return true;
+    }
+
+    if (FPlatformTime::Seconds() - startTime > ThumbnailTimeoutSeconds) {
+        UE_LOG(LogTemp, Warning, TEXT("Thumbnail readback timed out, saving without it - FALSThumbnailCapture"));
+        ReleaseObjects();
+        return true;
+    }
+
+    // One poll in flight at a time, the readback is only touched on the render thread
+    if (!bPollPending) {
+        bPollPending = true;
+        TSharedRef<FALSThumbnailCapture, ESPMode::ThreadSafe> self = AsShared();
+        ENQUEUE_RENDER_COMMAND(ALSThumbnailPoll)
+        ([self](FRHICommandListImmediate& RHICmdList) {
+            if (!self->readback->IsReady()) {
+                self->bPollPending = false;
+                return;
+            }
+
+            FALSThumbnailPixels pixels;
+            self->ReadPixels(pixels);
+            AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [self, pixels = MoveTemp(pixels)]() {
+                self->Encode(pixels);
+                self->bComplete = true;
+            });
+        });
+    }
+    return false;
+}
+
+void FALSThumbnailCapture::ReleaseObjects()
+{
+    check(IsInGameThread());
+
+    if (captureComponent) {
+        captureComponent->UnregisterComponent();
+    }
+    captureComponent.Reset();
+    renderTarget.Reset();
+}
+
+void FALSThumbnailCapture::ReadPixels(FALSThumbnailPixels& outPixels)
+{
+    check(IsInRenderingThread());
+
+    int32 rowPitch = 0;
+    const uint8* source = static_cast<const uint8*>(readback->Lock(rowPitch));
+    if (source && rowPitch >= width) {
+        outPixels.Width = width;
+        outPixels.Height = height;
+        outPixels.Data.SetNumUninitialized(width * height * 4);
+
+        // Readback rows are padded to the pitch of the platform
+        for (int32 row = 0; row < height; row++) {
+            FMemory::Memcpy(outPixels.Data.GetData() + row * width * 4, source + row * rowPitch * 4, width * 4);
+        }
+    }
+    readback->Unlock();
+}
+
+void FALSThumbnailCapture::Encode(const FALSThumbnailPixels& pixels)
+{
+    if (pixels.Data.Num() == 0) {
+        return;
+    }
+
+    // The scene capture leaves scene depth in the alpha channel
+    FALSThumbnailPixels opaquePixels = pixels;
+    for (int32 index = 3; index < opaquePixels.Data.Num(); index += 4) {
+        opaquePixels.Data[index] = 255;
+    }
+    FALSThumbnailCodec::EncodePNG(opaquePixels, encodedData);
+}
+
+void FALSThumbnailCodec::LoadModules()
+{
+    check(IsInGameThread());
+    GetImageWrapperModule();
+}
+
+bool FALSThumbnailCodec::EncodePNG(const FALSThumbnailPixels& pixels, TArray<uint8>& outPng)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSThumbnailEncode);
+
+    IImageWrapperModule& imgWrapperModule = GetImageWrapperModule();
+    TSharedPtr<IImageWrapper> imgWrapper = imgWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+    if (!imgWrapper.IsValid() || !imgWrapper->SetRaw(pixels.Data.GetData(), pixels.Data.Num(), pixels.Width, pixels.Height, ERGBFormat::BGRA, 8)) {
+        return false;
+    }
+
+    const TArray64<uint8>& compressed = imgWrapper->GetCompressed();
+    outPng = TArray<uint8>(compressed.GetData(), compressed.Num());
+    return outPng.Num() > 0;
+}
+
+bool FALSThumbnailCodec::DecodePNG(const TArray<uint8>& png, FALSThumbnailPixels& outPixels)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ALSThumbnailDecode);
+
+    IImageWrapperModule& imgWrapperModule = GetImageWrapperModule();
+    TSharedPtr<IImageWrapper> imgWrapper = imgWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+    if (!imgWrapper.IsValid() || !imgWrapper->SetCompressed(png.GetData(), png.Num())) {
+        return false;
+    }
+
+    TArray64<uint8> uncompressedBGRA;
+    if (!imgWrapper->GetRaw(ERGBFormat::BGRA, 8, uncompressedBGRA)) {
+        return false;
+    }
+
+    outPixels.Width = imgWrapper->GetWidth();
+    outPixels.Height = imgWrapper->GetHeight();
+    outPixels.Data = TArray<uint8>(uncompressedBGRA.GetData(), uncompressedBGRA.Num());
+    return true;
+}
+
+UTexture2D* FALSThumbnailCodec::CreateTexture(const FALSThumbnailPixels& pixels)
+{
+    check(IsInGameThread());
+
+    if (pixels.Width <= 0 || pixels.Height <= 0 || pixels.Data.Num() != pixels.Width * pixels.Height * 4) {
+        return nullptr;
+    }
+
+    UTexture2D* texture = UTexture2D::CreateTransient(pixels.Width, pixels.Height, PF_B8G8R8A8);
+    if (!texture) {
+        return nullptr;
+    }
+    void* textureData = texture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(textureData, pixels.Data.GetData(), pixels.Data.Num());
+    texture->GetPlatformData()->Mips[0].BulkData.Unlock();
+    texture->UpdateResource();
+    return texture;
+}
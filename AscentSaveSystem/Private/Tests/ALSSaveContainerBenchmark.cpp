@@ -0,0 +1,114 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ALSSaveContainer.h"
+#include "ALSSaveGame.h"
+#include "ALSSaveTypes.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ALSSaveContainerBenchmark {
+
+static const TCHAR* LevelName = TEXT("ALSBenchmarkLevel");
+
+static void FillRecord(FALSObjectData& record, const FName& name, FRandomStream& stream, const int32 dataSize)
+{
+    record.alsName = name;
+    record.Class = AActor::StaticClass();
+    record.Data.SetNumUninitialized(dataSize);
+    for (uint8& byte : record.Data) {
+        // Mostly small values, like the properties of a real actor
+        byte = static_cast<uint8>(stream.RandRange(0, 15));
+    }
+}
+
+/*A level with numActors records of two components each, the same on every run*/
+static UALSSaveGame* CreateSyntheticSave(const int32 numActors)
+{
+    UALSSaveGame* saveGame = NewObject<UALSSaveGame>(GetTransientPackage());
+    FRandomStream stream(numActors);
+
+    FALSLevelData level;
+    for (int32 index = 0; index < numActors; index++) {
+        FALSActorData actorData;
+        FillRecord(actorData, FName(TEXT("BenchmarkActor"), index), stream, 96);
+        actorData.Transform = FTransform(FRotator(0.f, stream.FRandRange(0.f, 360.f), 0.f), stream.GetUnitVector() * 50000.f);
+        actorData.Tags.Add(TEXT("Benchmark"));
+
+        for (int32 compIndex = 0; compIndex < 2; compIndex++) {
+            FALSComponentData compData;
+            FillRecord(compData, FName(TEXT("BenchmarkComponent"), compIndex), stream, 48);
+            actorData.AddComponentData(compData);
+        }
+        level.AddActorRecord(MoveTemp(actorData));
+    }
+    saveGame->AddLevel(LevelName, MoveTemp(level));
+    return saveGame;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSSaveContainerBenchmark, "AscentSaveSystem.SaveContainer.Benchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FALSSaveContainerBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace ALSSaveContainerBenchmark;
+
+    const int32 worldSizes[] = { 1000, 10000, 50000 };
+    for (const int32 numActors : worldSizes) {
+        const FString slotName = FString::Printf(TEXT("ALSBenchmark_%d"), numActors);
+        FALSSaveContainer::DeleteSlot(slotName);
+
+        UALSSaveGame* saveGame = CreateSyntheticSave(numActors);
+
+        double startTime = FPlatformTime::Seconds();
+        const bool bSaved = FALSSaveContainer::SaveGameToSlot(saveGame, slotName);
+        const double saveMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+        if (!TestTrue(FString::Printf(TEXT("%d actors are saved"), numActors), bSaved)) {
+            continue;
+        }
+        const int64 fileSize = IFileManager::Get().FileSize(*FALSSaveContainer::GetSlotPath(slotName));
+
+        // The level is unchanged, so this write copies its compressed chunk as it is
+        startTime = FPlatformTime::Seconds();
+        TestTrue(TEXT("The unchanged save is written again"), FALSSaveContainer::SaveGameToSlot(saveGame, slotName));
+        const double resaveMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+
+        startTime = FPlatformTime::Seconds();
+        UALSSaveGame* loadedGame = FALSSaveContainer::LoadGameFromSlot(slotName);
+        const double loadMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+        if (!TestNotNull(TEXT("The save is loaded"), loadedGame)) {
+            FALSSaveContainer::DeleteSlot(slotName);
+            continue;
+        }
+
+        startTime = FPlatformTime::Seconds();
+        const bool bPrefetched = loadedGame->PrefetchLevel(LevelName);
+        const double levelMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+
+        const FALSLevelData* loadedLevel = loadedGame->FindLoadedLevel(LevelName);
+        if (TestTrue(TEXT("The level is read back"), bPrefetched && loadedLevel)) {
+            const FALSLevelData* savedLevel = saveGame->FindLoadedLevel(LevelName);
+            TestEqual(TEXT("Every actor record is read back"), loadedLevel->GetActors().Num(), numActors);
+            if (savedLevel && loadedLevel->GetActors().Num() == numActors) {
+                const FALSActorData& savedLast = savedLevel->GetActors().Last();
+                const FALSActorData& loadedLast = loadedLevel->GetActors().Last();
+                TestEqual(TEXT("Records keep their name"), loadedLast.GetName(), savedLast.GetName());
+                TestTrue(TEXT("Records keep their data"), loadedLast.Data == savedLast.Data && loadedLast.Transform.Equals(savedLast.Transform));
+            }
+        }
+
+        AddInfo(FString::Printf(TEXT("%d actors: save %.2f ms, unchanged save %.2f ms, load %.2f ms, level read %.2f ms, %lld bytes"),
+            numActors, saveMs, resaveMs, loadMs, levelMs, fileSize));
+
+        FALSSaveContainer::DeleteSlot(slotName);
+    }
+    return true;
+}
+
+#endif
@@ -8,6 +8,11 @@
 
 struct FALSActorData;
 
+enum class EALSComponentCallback : uint8 {
+	ESaved,
+	ELoaded
+};
+
 /**
  * 
  */
@@ -27,6 +32,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ALS)
 	static bool ShouldSaveActor(AActor* actor);
 
+	/*Flags the actor to be serialized again by the next save. Savable components can call it on their owner*/
+	UFUNCTION(BlueprintCallable, Category = ALS)
+	static void MarkActorDirty(AActor* actor);
+
 	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject"), Category = ALS)
 	static bool IsNewGame(const UObject* WorldContextObject);
 
@@ -38,17 +47,27 @@ public:
 
 	static void ExecuteFunctionsOnSavableActor(AActor* actorOwner, const FName& functionName);
 
+	/*Calls the save or load hook of each component, directly if it implements IALSSavableComponentInterface
+	and through the function named in the settings otherwise. How to call each class is resolved once*/
+	static void ExecuteComponentCallbacks(const TArray<UActorComponent*>& components, const EALSComponentCallback callback);
+
 	static void DeserializeActor(AActor* Actor, const FALSActorData& Record);
 
+	static void DeserializeActor(AActor* Actor, const FALSActorData& Record, const TArray<UActorComponent*>& Components);
+
 	static void FullDeserializeActor(AActor* Actor, const FALSActorData& Record, bool bLoadTransform);
 
 
 	static void DeserializeActorComponents(AActor* Actor, const FALSActorData& ActorRecord);
 
+	static void DeserializeComponents(const TArray<UActorComponent*>& Components, const FALSActorData& ActorRecord);
+
 	static FALSActorData SerializeActor(AActor* actor);
 
 	static void SerializeComponents(const AActor* Actor, FALSActorData& ActorRecord);
 
+	static void SerializeComponents(const TArray<UActorComponent*>& Components, FALSActorData& ActorRecord);
+
 	static FString ConstructScreenshotPath(const FString& fileName);
 
 };
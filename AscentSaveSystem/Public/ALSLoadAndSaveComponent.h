@@ -33,13 +33,45 @@ public:
 
     void DispatchLoaded();
 
+    /*Flags the owner as changed, so that the next save serializes it again. Call it whenever a savable property changes*/
+    UFUNCTION(BlueprintCallable, Category = ALS)
+    void MarkDirty()
+    {
+        bDirty = true;
+    }
+
+    /*Whether the owner changed since it was last serialized. Always true for owners that don't track their dirty state*/
+    UFUNCTION(BlueprintPure, Category = ALS)
+    bool IsDirty() const;
+
+    bool ShouldTrackDirtyState() const
+    {
+        return bTrackDirtyState;
+    }
+
+    /*Whether the record of the owner in the provided slot is still up to date*/
+    bool IsSavedIn(const FString& slotName) const
+    {
+        return !IsDirty() && lastSavedSlot == slotName;
+    }
+
+    /*Called once the owner has been serialized in the provided slot*/
+    void ClearDirty(const FString& slotName);
+
 protected:
     // Called when the game starts
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     UPROPERTY(EditAnywhere, Category = ALS)
     bool bAutoReload = true;
 
+    /*If enabled, saves reuse the previous record of the owner until MarkDirty is called or the owner moves,
+    instead of serializing it every time. Only enable it if every change to a savable property calls MarkDirty*/
+    UPROPERTY(EditAnywhere, Category = ALS)
+    bool bTrackDirtyState = false;
+
 
     UPROPERTY(BlueprintAssignable, Category = ALS)
     FOnActorSaved OnActorSaved;
@@ -52,5 +84,11 @@ private:
 
     bool bAlreadyLoaded;
 
+    bool bDirty = true;
+
+    FTransform lastSavedTransform;
+
+    FString lastSavedSlot;
+
     UALSLoadAndSaveSubsystem* GetSaveSubsystem() const;
 };
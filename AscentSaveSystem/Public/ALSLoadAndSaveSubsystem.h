@@ -7,6 +7,8 @@
 #include "ALSSaveGameSettings.h"
 #include "ALSSaveInfo.h"
 #include "ALSSaveTask.h"
+#include "ALSThumbnail.h"
+#include "Containers/Ticker.h"
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
 #include "Kismet/GameplayStatics.h"
@@ -27,6 +29,9 @@ enum class ELoadingState : uint8 {
     ELoading
 };
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLoadProgress, float, Progress);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnThumbnailLoaded, const FString&, SaveName, UTexture2D*, Thumbnail);
+
 UCLASS()
 class ASCENTSAVESYSTEM_API UALSLoadAndSaveSubsystem : public UGameInstanceSubsystem {
     GENERATED_BODY()
@@ -48,6 +53,11 @@ public:
     void SaveGameWorldInCurrentSlot(const FOnSaveFinished& saveCallback, const bool bSaveLocalPlayer = true, 
         const bool bSaveScreenshot = true, const FString& slotDescription = "");
 
+    /*Saves the game world in the current slot. If the autosave journal is enabled, only the actors that changed
+    are appended to the slot, and every few autosaves the slot is rewritten as a whole*/
+    UFUNCTION(BlueprintCallable, Category = ALS)
+    void AutoSaveGameWorld(const FOnSaveFinished& saveCallback, const bool bSaveLocalPlayer = true);
+
     /*Load the provided slot and open the saved map*/
     UFUNCTION(BlueprintCallable, Category = ALS)
     void LoadGameWorld(const FString& slotName, const FOnLoadFinished& loadCallback);
@@ -89,6 +99,10 @@ public:
     bool CreateOrUpdateSlotInfo(const FString& slotName);
     bool RemoveSlotInfo(const FString& slotName);
 
+    /*Deletes the provided slot and removes it from the metadata index*/
+    UFUNCTION(BlueprintCallable, Category = ALS)
+    bool DeleteSaveGame(const FString& slotName);
+
 
     /*Reloads the player from the provided slot Usefull for multiplayer Games */
     UFUNCTION(BlueprintCallable, Category = ALS)
@@ -117,9 +131,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = ALS)
     class UALSSaveGame* LoadOrCreateSaveGame(const FString& slotName);
 
+    /*Metadata index of every slot, kept in memory once loaded*/
     UFUNCTION(BlueprintCallable, Category = ALS)
     class UALSSaveInfo* LoadOrCreateSaveInfo();
 
+    /*Whether the metadata index has been loaded, the first slot query before that reads it from disk*/
+    UFUNCTION(BlueprintPure, Category = ALS)
+    bool IsSaveIndexReady() const
+    {
+        return saveIndex != nullptr;
+    }
+
     UFUNCTION(BlueprintPure, Category = ALS)
     TArray<FALSSaveMetadata> GetAllSaveGames() const;
 
@@ -138,9 +160,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = ALS)
     bool IsSlotNameUnique(const FString& slotName) const;
 
+    /*Decodes the thumbnail on the game thread unless it is cached, prefer GetScreenshotForSaveAsync for slot lists*/
     UFUNCTION(BlueprintCallable, Category = ALS)
     UTexture2D* GetScreenshotForSave(const FString& saveName) const;
 
+    /*Reads and decodes the thumbnail of the slot on a worker. The callback runs on the game thread,
+    right away if the thumbnail is cached, with a null texture if the slot has none*/
+    UFUNCTION(BlueprintCallable, Category = ALS)
+    void GetScreenshotForSaveAsync(const FString& saveName, const FOnThumbnailLoaded& callback);
+
     UFUNCTION(BlueprintPure, Category = ALS)
     ELoadingState GetSystemState() const
     {
@@ -176,6 +204,17 @@ public:
 
     void FinishLoadWork(const bool bSuccess);
 
+    /*Spawns the missing actors of a load, across frames if a spawn budget is set, then finishes it*/
+    void ApplyLoadResult(const TSharedPtr<FALSLoadResult>& result, const bool bSuccess);
+
+    void RegisterSaveComponent(UALSLoadAndSaveComponent* saveComp);
+
+    void UnregisterSaveComponent(UALSLoadAndSaveComponent* saveComp);
+
+    /*Broadcast every frame while the actors of a load are spawned, from 0 to 1*/
+    UPROPERTY(BlueprintAssignable, Category = ALS)
+    FOnLoadProgress OnLoadProgress;
+
 private:
     ELoadType loadType = ELoadType::EDontReload;
     bool bIsLoading;
@@ -188,6 +227,18 @@ private:
 
     void AsyncLoadSaveGame(const FString& savegameName);
 
+    UFUNCTION()
+    void HandleSaveIndexLoaded(const FString& SaveSlot, const int32 UserIndex, USaveGame* LoadedSaveData);
+
+    /*Drops the entries whose slot is gone and adds the containers missing from the index, checked off the game thread*/
+    void ValidateSaveIndex();
+
+    void ApplySaveIndexFixes(const TArray<FString>& missingSlots, const TArray<FALSSaveMetadata>& unindexedSlots);
+
+    bool WriteSaveIndex();
+
+    const class UALSSaveInfo* GetSaveIndex() const;
+
     void SerializeObject(UObject* objectToSerialize, FALSObjectData& outData);
     void DeserializeObject(UObject* settingsObject, const FALSObjectData& objectData);
 
@@ -204,6 +255,71 @@ private:
     
     UPROPERTY()
     TArray<FALSActorData> ExtraActors;
+
+    /*Game thread phase of the save in progress, captured a slice per frame*/
+    TUniquePtr<FALSWorldSnapshot> saveSnapshot;
+
+    FTSTicker::FDelegateHandle saveTickerHandle;
+
+    FString pendingSlotDescription;
+
+    /*Thumbnail of the save in progress, written with it once read back*/
+    TSharedPtr<FALSThumbnailCapture, ESPMode::ThreadSafe> thumbnailCapture;
+
+    bool bSnapshotCaptured = false;
+
+    UPROPERTY()
+    class UALSSaveInfo* saveIndex;
+
+    double saveStartTime = 0.0;
+
+    double saveMaxSliceTime = 0.0;
+
+    int32 saveSnapshotFrames = 0;
+
+    /*Components flagged as saved by the save in progress*/
+    TArray<TWeakObjectPtr<UALSLoadAndSaveComponent>> savedComponents;
+
+    void StartSave(const FString& slotName, const FOnSaveFinished& saveCallback, const bool bSaveLocalPlayer,
+        const bool bSaveScreenshot, const FString& slotDescription, const bool bDelta);
+
+    bool TickSaveSnapshot(float deltaTime);
+
+    /*Hands the completed snapshot over to the FSaveWorldTask*/
+    void StartSaveWrite();
+
+    /*Components of the actors in play, restored by loads without iterating every object*/
+    TSet<TWeakObjectPtr<UALSLoadAndSaveComponent>> saveComponents;
+
+    TSharedPtr<FALSLoadResult> pendingLoad;
+
+    int32 nextSpawn = 0;
+
+    FTSTicker::FDelegateHandle loadTickerHandle;
+
+    bool TickLoadSpawn(float deltaTime);
+
+    void CompleteLoad();
+
+    /*Decoded thumbnails, evicted least recently used first*/
+    UPROPERTY()
+    TMap<FString, UTexture2D*> thumbnailCache;
+
+    // Most recently used last
+    TArray<FString> thumbnailUsage;
+
+    TMap<FString, TArray<FOnThumbnailLoaded>> pendingThumbnails;
+
+    // Bumped whenever a thumbnail is invalidated, decodes started before are not cached
+    int32 thumbnailCacheEpoch = 0;
+
+    void HandleThumbnailDecoded(const FString& saveName, const FALSThumbnailPixels& pixels, const int32 cacheEpoch);
+
+    void CacheThumbnail(const FString& saveName, UTexture2D* thumbnail);
+
+    void InvalidateThumbnail(const FString& saveName);
+
+    void CancelThumbnailCapture();
 };
 
 static void GFinishSave(UWorld* WorldContextObject, bool bSuccess)
@@ -211,39 +327,7 @@ static void GFinishSave(UWorld* WorldContextObject, bool bSuccess)
     UGameplayStatics::GetGameInstance(WorldContextObject)->GetSubsystem<UALSLoadAndSaveSubsystem>()->FinishSaveWork(bSuccess);
 }
 
-static void GFinishLoad(UWorld* WorldContextObject,  TArray<FALSActorData> ToBeSpawned,
-    TMap<AActor*, FALSActorLoaded> SavedActors, TArray<AActor*> ToBeDestroyed, TArray<UALSLoadAndSaveComponent*> wpActors, bool bSuccess)
+static void GFinishLoad(UWorld* WorldContextObject, TSharedPtr<FALSLoadResult> result, bool bSuccess)
 {
-    const UALSSaveGameSettings* saveSettings = GetMutableDefault<UALSSaveGameSettings>();
-    if (bSuccess && saveSettings) {
-        for (const auto& actor : ToBeDestroyed) {
-            actor->Destroy();
-        }
-        FActorSpawnParameters SpawnInfo {};
-        for (const auto& Record : ToBeSpawned) {
-            // SpawnInfo.Name = Record.alsName;
-            AActor* spawnedActor = WorldContextObject->SpawnActor(Record.Class, &Record.Transform, SpawnInfo);
-            if (spawnedActor) {
-                UALSFunctionLibrary::DeserializeActor(spawnedActor, Record);
-
-                UALSFunctionLibrary::ExecuteFunctionsOnSavableActor(spawnedActor,
-                    saveSettings->GetOnComponentLoadedFunctionName());
-            }
-        }
-
-        for (const auto& actorRec : SavedActors) {
-            if (!actorRec.Key) {
-                continue;
-            }
-            actorRec.Key->SetActorTransform(actorRec.Value.transform);
-
-            UALSFunctionLibrary::ExecuteFunctionsOnSavableActor(actorRec.Key,
-                saveSettings->GetOnComponentLoadedFunctionName());
-        }
-
-        for (const auto& comp : wpActors) {
-            comp->DispatchLoaded();
-        }
-    }
-    UGameplayStatics::GetGameInstance(WorldContextObject)->GetSubsystem<UALSLoadAndSaveSubsystem>()->FinishLoadWork(bSuccess);
+    UGameplayStatics::GetGameInstance(WorldContextObject)->GetSubsystem<UALSLoadAndSaveSubsystem>()->ApplyLoadResult(result, bSuccess);
 }
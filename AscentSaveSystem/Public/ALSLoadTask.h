@@ -19,6 +19,20 @@ class UALSLoadAndSaveComponent;
  */
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnLoadFinished, const bool, Success);
 
+/*What the FLoadWorldTask leaves to the game thread, applied by the subsystem across frames*/
+struct FALSLoadResult {
+    FString levelName;
+
+    // Records of the level without an actor in the world, by index
+    TArray<int32> toBeSpawned;
+
+    TArray<TPair<TWeakObjectPtr<AActor>, FALSActorLoaded>> loadedActors;
+
+    TArray<TWeakObjectPtr<AActor>> toBeDestroyed;
+
+    TArray<TWeakObjectPtr<UALSLoadAndSaveComponent>> wpActors;
+};
+
 class FLoadWorldTask : public FNonAbandonableTask {
 
     FString saveName;
@@ -27,7 +41,8 @@ class FLoadWorldTask : public FNonAbandonableTask {
     bool bLoadAll;
 
 public:
-    FLoadWorldTask(const FString& slotName, UWorld* inWorld, const FString& inLevel, const bool loadLocalPlayer)
+    FLoadWorldTask(const FString& slotName, UWorld* inWorld, const FString& inLevel, const bool loadLocalPlayer,
+        const TArray<TWeakObjectPtr<UALSLoadAndSaveComponent>>& inSaveComponents)
     {
         saveName = slotName;
         world = inWorld;
@@ -36,9 +51,9 @@ public:
         if (world) {
             UGameplayStatics::GetAllActorsWithInterface(world, UALSSavableInterface::StaticClass(), LoadableActors);
         }
-        SuccessfullyLoadedActors.Empty();
-        ToBeDestroyed.Empty();
-        ToBeSpawned.Empty();
+        LoadableComponents = inSaveComponents;
+        result = MakeShared<FALSLoadResult>();
+        result->levelName = inLevel;
     }
 
     void DoWork();
@@ -57,10 +72,9 @@ private:
     void ReloadPlayer();
 
     TArray<AActor*> LoadableActors;
-    TMap<AActor*, FALSActorLoaded> SuccessfullyLoadedActors;
-    TArray<AActor*> ToBeDestroyed;
-    TArray<FALSActorData> ToBeSpawned;
-    TArray<UALSLoadAndSaveComponent*> wpActors;
+    TArray<TWeakObjectPtr<UALSLoadAndSaveComponent>> LoadableComponents;
+
+    TSharedPtr<FALSLoadResult> result;
 
 public:
     FORCEINLINE TStatId GetStatId() const
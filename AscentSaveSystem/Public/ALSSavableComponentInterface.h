@@ -0,0 +1,30 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+
+#include "ALSSavableComponentInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UALSSavableComponentInterface : public UInterface {
+    GENERATED_BODY()
+};
+
+/**
+ * Native save and load hooks for the components returned by GetComponentsToSave.
+ * Components implementing it are called directly, the functions named in the
+ * settings are only looked up for the ones that don't, or whose blueprint overrides them
+ */
+class ASCENTSAVESYSTEM_API IALSSavableComponentInterface {
+    GENERATED_BODY()
+
+public:
+    /*Called right before the component is serialized*/
+    virtual void NativeOnComponentSaved() { }
+
+    /*Called once the owner and all of its components have been restored*/
+    virtual void NativeOnComponentLoaded() { }
+};
@@ -0,0 +1,130 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "ALSSaveInfo.h"
+#include "CoreMinimal.h"
+
+class UALSSaveGame;
+struct FALSJournalEntry;
+struct FALSLevelData;
+
+/** Location of a compressed block inside a save container */
+struct FALSSaveChunk {
+    FString Name;
+
+    int64 Offset = 0;
+
+    int32 CompressedSize = 0;
+
+    int32 UncompressedSize = 0;
+
+    // NAME_None if the chunk is stored uncompressed
+    FName Format;
+
+    // Crc of the stored bytes
+    uint32 Checksum = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FALSSaveChunk& Chunk);
+};
+
+/** Chunk table of a save container, stored at the end of the file */
+struct FALSSaveTable {
+    FString SaveGameClass;
+
+    // Every property of the save game, except for its levels
+    FALSSaveChunk GameChunk;
+
+    // One chunk per saved level
+    TArray<FALSSaveChunk> LevelChunks;
+
+    // Copy of the entry of the slot in the metadata index, used to rebuild it. Since version 2
+    FALSSaveMetadata Metadata;
+
+    // PNG thumbnail of the slot, stored uncompressed. Since version 3
+    FALSSaveChunk ThumbnailChunk;
+
+    // New for every write of the container, a journal only applies to the generation in its header. Since version 4
+    FGuid Generation;
+
+    friend FArchive& operator<<(FArchive& Ar, FALSSaveTable& Table);
+};
+
+/** What is read from a container before the save game object is created */
+struct FALSSaveContainerContents {
+    FString Path;
+
+    FALSSaveTable Table;
+
+    TArray<uint8> GameData;
+
+    // Uncompressed delta saves appended after the container was written, oldest first
+    TArray<TArray<uint8>> JournalEntries;
+
+    // End of the last valid journal entry, anything past it is a torn tail
+    int64 JournalSize = 0;
+};
+
+/**
+ * Versioned save file: a fixed header, a compressed chunk for the save game and one for each level,
+ * and the chunk table. Chunks are streamed to disk one at a time, and levels are only decompressed
+ * when they are requested. Slots written by UGameplayStatics are still read as a fallback.
+ * Delta saves are appended to a journal next to the container, replayed on load and dropped
+ * whenever the container is written again.
+ */
+class ASCENTSAVESYSTEM_API FALSSaveContainer {
+
+public:
+    static constexpr uint32 Magic = 0x414C5343; // ALSC
+
+    static constexpr int32 Version = 4;
+
+    static constexpr uint32 JournalMagic = 0x414C534A; // ALSJ
+
+    static FString GetSlotPath(const FString& slotName);
+
+    static FString GetJournalPath(const FString& slotName);
+
+    static bool DoesSlotExist(const FString& slotName);
+
+    /*Safe on worker threads, as long as nothing else is using the save game*/
+    static bool SaveGameToSlot(UALSSaveGame* saveGame, const FString& slotName);
+
+    /*Reads the header and the chunk table only. Safe on worker threads*/
+    static bool ReadTable(const FString& slotName, FALSSaveTable& outTable);
+
+    /*Reads the header, the chunk table and the game chunk. Safe on worker threads*/
+    static bool ReadContents(const FString& slotName, FALSSaveContainerContents& outContents);
+
+    /*Builds the save game object from the contents read by ReadContents. Game thread only*/
+    static UALSSaveGame* CreateSaveGame(const FALSSaveContainerContents& contents);
+
+    /*Container first, legacy slot otherwise. Returns nullptr if the slot does not exist*/
+    static UALSSaveGame* LoadGameFromSlot(const FString& slotName);
+
+    static bool ReadLevel(const FString& path, const FALSSaveChunk& chunk, FALSLevelData& outLevel);
+
+    /*Reads the PNG thumbnail of the slot, false if it has none. Safe on worker threads*/
+    static bool ReadThumbnail(const FString& slotName, TArray<uint8>& outPng);
+
+    static bool DeleteSlot(const FString& slotName);
+
+    /*Appends a delta save to the journal of the slot, the caller still has to apply it to the save game.
+    False if the journal does not end where the save game expects it, the caller then writes a full save. Safe on worker threads*/
+    static bool AppendJournalEntry(UALSSaveGame* saveGame, const FString& slotName, const FALSJournalEntry& entry);
+
+private:
+    static bool ReadTable(FArchive& reader, const FString& path, FALSSaveTable& outTable);
+
+    static void ReadJournal(const FString& slotName, FALSSaveContainerContents& outContents);
+
+    static FName GetCompressionFormat();
+
+    static void CompressChunk(const TArray<uint8>& data, const FName& format, FALSSaveChunk& outChunk, TArray<uint8>& outPayload);
+
+    static void WriteChunk(FArchive& writer, const TArray<uint8>& data, const FName& format, FALSSaveChunk& outChunk);
+
+    static bool ReadChunk(FArchive& reader, const FALSSaveChunk& chunk, TArray<uint8>& outData);
+
+    static bool CopyChunk(FArchive& reader, FArchive& writer, const FALSSaveChunk& chunk, FALSSaveChunk& outChunk);
+};
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "ALSSaveContainer.h"
+#include "ALSSaveInfo.h"
 #include "ALSSaveTypes.h"
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
@@ -30,6 +32,34 @@ private:
     UPROPERTY(SaveGame)
     TArray<FALSActorData> ExtraActors;
 
+    // Container this save was read from or last written to, levels stay compressed there until requested
+    FString containerPath;
+
+    TMap<FString, FALSSaveChunk> levelChunks;
+
+    // Levels in memory that differ from their chunk in the container
+    TSet<FString> modifiedLevels;
+
+    // Delta saves appended to the container since it was last written
+    int32 journalEntries = 0;
+
+    // Bytes of the journal written for this container, 0 if it has none
+    int64 journalSize = 0;
+
+    // Generation of containerPath, invalid for containers written before version 4
+    FGuid containerGeneration;
+
+    // Entry of the slot in the metadata index, stored in the container to rebuild the index
+    FALSSaveMetadata slotMetadata;
+
+    // Thumbnail chunk in the container, copied as it is unless a new thumbnail is pending
+    FALSSaveChunk thumbnailChunk;
+
+    // PNG data captured for the next write
+    TArray<uint8> thumbnailData;
+
+    friend class FALSSaveContainer;
+
 public:
     void StoreWPActors(const FALSActorData& actorData)
     {
@@ -40,13 +70,18 @@ public:
     }
 
     bool TryGetStoredWPActor(AActor* actor, FALSActorData& outData) {
-        if (ExtraActors.Contains(actor->GetFName())) {
-            outData = *(ExtraActors.FindByKey(actor->GetFName()));
+        const FALSActorData* storedData = FindStoredWPActor(actor->GetFName());
+        if (storedData) {
+            outData = *storedData;
             return true;
         }
         return false;
     }
 
+    const FALSActorData* FindStoredWPActor(const FName& actorName) const {
+        return ExtraActors.FindByKey(actorName);
+    }
+
     void GetExtraActors(TArray<FALSActorData>& outActors) {
         outActors = ExtraActors;
     }
@@ -54,6 +89,53 @@ public:
     void AddLevel(const FString& levelName, const FALSLevelData& levelData)
     {
         Levels.Add(levelName, levelData);
+        modifiedLevels.Add(levelName);
+    }
+
+    void AddLevel(const FString& levelName, FALSLevelData&& levelData)
+    {
+        Levels.Add(levelName, MoveTemp(levelData));
+        modifiedLevels.Add(levelName);
+    }
+
+    /*Level records in memory, nullptr if the level has not been prefetched*/
+    const FALSLevelData* FindLoadedLevel(const FString& levelName) const
+    {
+        return Levels.Find(levelName);
+    }
+
+    /*Applies the changes of a delta save, decompressing its level first if needed*/
+    void ApplyJournalEntry(FALSJournalEntry&& entry);
+
+    int32 GetJournalEntries() const
+    {
+        return journalEntries;
+    }
+
+    const FString& GetContainerPath() const
+    {
+        return containerPath;
+    }
+
+    const FGuid& GetContainerGeneration() const
+    {
+        return containerGeneration;
+    }
+
+    const FALSSaveMetadata& GetSlotMetadata() const
+    {
+        return slotMetadata;
+    }
+
+    void SetSlotMetadata(const FALSSaveMetadata& inMetadata)
+    {
+        slotMetadata = inMetadata;
+    }
+
+    /*Replaces the thumbnail of the slot the next time the container is written*/
+    void SetThumbnail(TArray<uint8>&& pngData)
+    {
+        thumbnailData = MoveTemp(pngData);
     }
 
     void StoreLocalPlayer(const FALSPlayerData& actorData)
@@ -97,13 +179,21 @@ public:
     */
     bool TryGetLevelData(const FString& levelName, FALSLevelData& outData)
     {
-        if (Levels.Contains(levelName)) {
+        if (Levels.Contains(levelName) || PrefetchLevel(levelName)) {
             outData = *(Levels.Find(levelName));
             return true;
         }
         return false;
     }
 
+    bool HasLevel(const FString& levelName) const
+    {
+        return Levels.Contains(levelName) || levelChunks.Contains(levelName);
+    }
+
+    /*Decompresses the provided level from the container, if it is not in memory yet*/
+    bool PrefetchLevel(const FString& levelName);
+
 
 
     // Called before saving this slot
@@ -46,6 +46,39 @@ protected:
     UPROPERTY(EditAnywhere, config, Category = "ALS | Screenshot")
     int32 MaxSlotsNum = 8;
 
+    /*Size of the thumbnail rendered and stored inside each save*/
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 16), Category = "ALS | Screenshot")
+    int32 ThumbnailWidth = 480;
+
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 16), Category = "ALS | Screenshot")
+    int32 ThumbnailHeight = 270;
+
+    /*Decoded thumbnails kept in memory, the least recently used one is dropped first*/
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 1), Category = "ALS | Screenshot")
+    int32 ThumbnailCacheSize = 16;
+
+    /*Game thread time that the world snapshot of a save can take each frame, in milliseconds.
+    At least one actor is captured every frame no matter the budget*/
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 0.1), Category = "ALS | Performance")
+    float SnapshotBudgetMs = 2.f;
+
+    /*Game thread time that spawning the missing actors of a load can take each frame, in milliseconds.
+    0 spawns all of them in the same frame*/
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 0), Category = "ALS | Performance")
+    float SpawnBudgetMs = 0.f;
+
+    /*Compression used for the chunks of the save files, None to store them uncompressed*/
+    UPROPERTY(EditAnywhere, config, Category = "ALS | Performance")
+    FName SaveCompressionFormat = "Oodle";
+
+    /*Autosaves only append the actors that changed to a journal next to the save, instead of rewriting it*/
+    UPROPERTY(EditAnywhere, config, Category = "ALS | Performance")
+    bool bUseAutosaveJournal = true;
+
+    /*Autosaves appended to the journal before the next one rewrites the whole save*/
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 1, EditCondition = "bUseAutosaveJournal"), Category = "ALS | Performance")
+    int32 AutosaveJournalMaxEntries = 16;
+
 public:
     TSubclassOf<class UALSSaveGame> GetSaveGameClass() const
     {
@@ -77,11 +110,51 @@ public:
         return SaveScreenWidth;
     }
 
+    int32 GetThumbnailWidth() const
+    {
+        return ThumbnailWidth;
+    }
+
+    int32 GetThumbnailHeight() const
+    {
+        return ThumbnailHeight;
+    }
+
+    int32 GetThumbnailCacheSize() const
+    {
+        return ThumbnailCacheSize;
+    }
+
     int32 GetMaxSlotsNum() const
     {
         return MaxSlotsNum;
     }
 
+    float GetSnapshotBudgetMs() const
+    {
+        return SnapshotBudgetMs;
+    }
+
+    float GetSpawnBudgetMs() const
+    {
+        return SpawnBudgetMs;
+    }
+
+    FName GetSaveCompressionFormat() const
+    {
+        return SaveCompressionFormat;
+    }
+
+    bool GetUseAutosaveJournal() const
+    {
+        return bUseAutosaveJournal;
+    }
+
+    int32 GetAutosaveJournalMaxEntries() const
+    {
+        return AutosaveJournalMaxEntries;
+    }
+
     FName GetOnComponentSavedFunctionName() const
     {
         return OnComponentSavedFunctionName;
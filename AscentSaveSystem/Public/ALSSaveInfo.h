@@ -69,6 +69,16 @@ public:
         return SaveSlots;
     }
 
+    int32 GetNumSlots() const
+    {
+        return SaveSlots.Num();
+    }
+
+    bool HasSlot(const FString& SlotName) const
+    {
+        return SaveSlots.Contains(SlotName);
+    }
+
     void AddSlot(const FALSSaveMetadata& slotToAdd)
     {
         if (SaveSlots.Contains(slotToAdd)) {
@@ -18,42 +18,101 @@
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnSaveFinished, const bool, Success);
 
 
-class FSaveWorldTask : public FNonAbandonableTask {
+/*Plain data captured from the world on the game thread, handed over to the FSaveWorldTask*/
+struct FALSSaveSnapshot {
+	FString saveName;
+	FString mapName;
+	TArray<FALSActorData> actors;
+	TArray<FALSActorData> extraActors;
+	FALSPlayerData localPlayer;
+	bool bHasLocalPlayer = false;
+
+	/*Delta snapshots only hold the actors that changed, and are appended to the journal of the slot*/
+	bool bDelta = false;
+	TArray<FName> removedActors;
+};
+
+/*Serializes the savable actors of a world into plain buffers on the game thread,
+spreading the work across frames within a time budget.
+Actors that track their dirty state and did not change reuse their record from the previous save*/
+class FALSWorldSnapshot {
 
 public:
+	FALSWorldSnapshot(UWorld* inWorld, const FString& slotName, const bool saveLocalPlayer,
+		class UALSSaveGame* inPreviousSave = nullptr, const bool inDeltaOnly = false);
 
-	FString slotDesc;
-	FString saveName;
-	bool bSaveScreenshot;
+	/*Captures actors until the budget is spent, returns true once the snapshot is complete*/
+	bool CaptureSlice(const double budgetSeconds);
+
+	bool IsWorldValid() const
+	{
+		return world.IsValid();
+	}
+
+	int32 GetNumCapturedActors() const
+	{
+		return snapshot.actors.Num();
+	}
+
+	int32 GetNumReusedActors() const
+	{
+		return reusedActors;
+	}
+
+	FALSSaveSnapshot& GetSnapshot()
+	{
+		return snapshot;
+	}
+
+	/*Components flagged as saved by this snapshot, to be marked dirty again if the save fails*/
+	TArray<TWeakObjectPtr<class UALSLoadAndSaveComponent>>& GetClearedComponents()
+	{
+		return clearedComponents;
+	}
+
+private:
+	void CaptureActor(AActor* actor);
+
+	void CaptureLocalPlayer();
+
+	const FALSLevelData* FindPreviousLevel() const;
+
+	TWeakObjectPtr<UWorld> world;
+	TArray<TWeakObjectPtr<AActor>> pendingActors;
+	int32 nextActor = 0;
 	bool bSaveLocalPlayer;
-	UWorld* world;
-        explicit FSaveWorldTask(const FString& slotName, UWorld* inWorld, const bool saveLocalPlayer, const bool inSaveScreenshot, FString inSlotDescription = "")
-        {
-		saveName = slotName;
-		slotDesc = inSlotDescription;
-		world = inWorld;
-		bSaveScreenshot = inSaveScreenshot;
-		bSaveLocalPlayer = saveLocalPlayer;
-		if (world) {
-			 UGameplayStatics::GetAllActorsWithInterface(world, UALSSavableInterface::StaticClass(), SavableActors);
-		}
-		SuccessfullySavedActors.Empty();
+
+	/*Current level in the previous save, looked up again every slice since the save game can reallocate it*/
+	TWeakObjectPtr<class UALSSaveGame> previousSave;
+	TBitArray<> seenRecords;
+	bool bDeltaOnly;
+	int32 reusedActors = 0;
+
+	TArray<TWeakObjectPtr<class UALSLoadAndSaveComponent>> clearedComponents;
+
+	FALSSaveSnapshot snapshot;
+};
+
+/*Builds the save game from a snapshot and writes it on a worker thread, never touching the world*/
+class FSaveWorldTask : public FNonAbandonableTask {
+
+public:
+
+	explicit FSaveWorldTask(FALSSaveSnapshot&& inSnapshot, UWorld* inWorld, class UALSSaveGame* inSave)
+		: snapshot(MoveTemp(inSnapshot))
+		, world(inWorld)
+		, newSave(inSave)
+	{
 	}
 
 	void DoWork();
 
 private:
-	FALSActorData SerializeActor(AActor* actor);
-
 	void FinishSave(const bool bSuccess);
 
-	void StoreLocalPlayer();
-
-	TArray<AActor*> SavableActors;
-	TArray<AActor*> SuccessfullySavedActors;
+	FALSSaveSnapshot snapshot;
+	UWorld* world;
 
-protected:
-	UPROPERTY(BlueprintReadOnly, Category = ALS)
 	class UALSSaveGame* newSave;
 
 public:
@@ -178,6 +178,21 @@ public:
 		return ComponentRecords.FindByKey(component->GetFName());
 	}
 
+	/** Records keep the order GetComponentsToSave returned the components in, so walking both lists
+	together matches each component on the first compare unless the list changed since the save */
+	const FALSComponentData* FindNextComponentData(const UActorComponent* component, int32& inOutCursor) const {
+		const FName name = component->GetFName();
+		if (ComponentRecords.IsValidIndex(inOutCursor) && ComponentRecords[inOutCursor] == name) {
+			return &ComponentRecords[inOutCursor++];
+		}
+		const int32 index = ComponentRecords.IndexOfByKey(name);
+		if (index == INDEX_NONE) {
+			return nullptr;
+		}
+		inOutCursor = index + 1;
+		return &ComponentRecords[index];
+	}
+
 	bool HasComponent(const UActorComponent* component) const {
 		return ComponentRecords.Contains(component->GetFName());
 	}
@@ -195,6 +210,9 @@ public:
 
 	virtual bool Serialize(FArchive& Ar) override;
 
+	/** True if both records would restore the actor in the same state */
+	bool HasSameState(const FALSActorData& Other) const;
+
 	FORCEINLINE bool operator== (const FALSActorData& Other) const
 	{
 		return this->alsName == Other.GetName();
@@ -237,31 +255,79 @@ protected:
 	/** Records of the World Actors */
 	UPROPERTY(SaveGame)
 	TArray<FALSActorData> Actors;
+
+	/** Position of each record in Actors by actor name, rebuilt after deserialization */
+	TMap<FName, int32> ActorIndex;
+
 public:
 
 	void AddActorRecord(const FALSActorData& actorData) {
-		Actors.Add(actorData);
+		ActorIndex.Add(actorData.GetName(), Actors.Add(actorData));
+	}
+
+	void AddActorRecord(FALSActorData&& actorData) {
+		const FName actorName = actorData.GetName();
+		ActorIndex.Add(actorName, Actors.Add(MoveTemp(actorData)));
 	}
 
 	TArray<FALSActorData> GetActorsCopy() const {
 		return Actors;
 	}
 
+	const TArray<FALSActorData>& GetActors() const {
+		return Actors;
+	}
+
+	/** Replaces the record with the same name, or adds it */
+	void UpdateActorRecord(FALSActorData&& actorData) {
+		const int32* index = ActorIndex.Find(actorData.GetName());
+		if (index) {
+			Actors[*index] = MoveTemp(actorData);
+		} else {
+			AddActorRecord(MoveTemp(actorData));
+		}
+	}
+
+	void RemoveActorRecord(const FName& actorName);
+
+	int32 FindActorRecordIndex(const FName& actorName) const {
+		const int32* index = ActorIndex.Find(actorName);
+		return index ? *index : INDEX_NONE;
+	}
+
+	const FALSActorData* FindActorRecord(const FName& actorName) const {
+		const int32* index = ActorIndex.Find(actorName);
+		return index ? &Actors[*index] : nullptr;
+	}
+
 	const FALSActorData* GetActorData(const AActor* actor) const {
-		return Actors.FindByKey(actor);
+		return FindActorRecord(actor->GetFName());
 	}	
 
 	bool HasActor(const AActor* actor) const {
-		return Actors.Contains(actor);
+		return ActorIndex.Contains(actor->GetFName());
 	}
 
 	FALSLevelData() {};
 	FALSLevelData(const ULevel* level) : Super(level) {}
 	virtual bool Serialize(FArchive& Ar) override;
 
+	void PostSerialize(const FArchive& Ar);
+
+	void RebuildActorIndex();
+
 	bool IsValid() const { return !alsName.IsNone(); }
 };
 
+template<>
+struct TStructOpsTypeTraits<FALSLevelData> : public TStructOpsTypeTraitsBase2<FALSLevelData>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
+
 USTRUCT()
 struct FALSActorLoaded 
 {
@@ -298,6 +364,34 @@ public:
 
 };
 
+/** Changes captured by a delta save, appended to the journal of a slot */
+USTRUCT()
+struct FALSJournalEntry
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(SaveGame)
+	FString LevelName;
+
+	/** Actors added or changed since the previous save */
+	UPROPERTY(SaveGame)
+	TArray<FALSActorData> Actors;
+
+	UPROPERTY(SaveGame)
+	TArray<FName> RemovedActors;
+
+	UPROPERTY(SaveGame)
+	TArray<FALSActorData> ExtraActors;
+
+	UPROPERTY(SaveGame)
+	bool bHasLocalPlayer = false;
+
+	UPROPERTY(SaveGame)
+	FALSPlayerData LocalPlayer;
+};
+
 UCLASS()
 class ASCENTSAVESYSTEM_API UALSSaveTypes : public UObject
 {
@@ -0,0 +1,88 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FRHIGPUTextureReadback;
+class UTexture2D;
+class UTextureRenderTarget2D;
+class USceneCaptureComponent2D;
+
+/** Uncompressed BGRA8 pixels of a save thumbnail */
+struct FALSThumbnailPixels {
+    int32 Width = 0;
+
+    int32 Height = 0;
+
+    TArray<uint8> Data;
+};
+
+/**
+ * Captures the view of the local player into a small render target for a save slot.
+ * The render target is read back without stalling the render thread and encoded to PNG on a worker.
+ * Nothing is captured on a null RHI, the save simply goes on without a thumbnail.
+ */
+class ASCENTSAVESYSTEM_API FALSThumbnailCapture : public TSharedFromThis<FALSThumbnailCapture, ESPMode::ThreadSafe> {
+
+public:
+    FALSThumbnailCapture(const int32 inWidth, const int32 inHeight);
+
+    static bool CanCapture();
+
+    /*Renders the view of the first local player, returns false if nothing can be captured. Game thread only*/
+    bool Start(UWorld* world);
+
+    /*Polled on the game thread, returns true once the capture is encoded, failed or timed out*/
+    bool Tick();
+
+    bool IsComplete() const
+    {
+        return bComplete;
+    }
+
+    /*PNG data, only valid once complete and empty if the capture failed*/
+    TArray<uint8>& GetEncodedData()
+    {
+        return encodedData;
+    }
+
+    /*Releases the render target and the capture component. Game thread only*/
+    void ReleaseObjects();
+
+private:
+    void ReadPixels(FALSThumbnailPixels& outPixels);
+
+    void Encode(const FALSThumbnailPixels& pixels);
+
+    int32 width;
+    int32 height;
+    double startTime = 0.0;
+
+    TStrongObjectPtr<UTextureRenderTarget2D> renderTarget;
+    TStrongObjectPtr<USceneCaptureComponent2D> captureComponent;
+    TSharedPtr<FRHIGPUTextureReadback, ESPMode::ThreadSafe> readback;
+
+    TAtomic<bool> bPollPending { false };
+    TAtomic<bool> bComplete { false };
+
+    TArray<uint8> encodedData;
+};
+
+/** PNG encoding and decoding of save thumbnails */
+struct ASCENTSAVESYSTEM_API FALSThumbnailCodec {
+
+    /*Workers can't load modules, called on the game thread before handing them any work*/
+    static void LoadModules();
+
+    /*Safe on worker threads*/
+    static bool EncodePNG(const FALSThumbnailPixels& pixels, TArray<uint8>& outPng);
+
+    /*Safe on worker threads*/
+    static bool DecodePNG(const TArray<uint8>& png, FALSThumbnailPixels& outPixels);
+
+    /*Game thread only*/
+    static UTexture2D* CreateTexture(const FALSThumbnailPixels& pixels);
+};
@@ -40,7 +40,8 @@ public class AscentTargetingSystem : ModuleRules
 				"Slate",
 				"SlateCore",
 				"AIModule",
-                 "AscentCoreInterfaces"
+                 "AscentCoreInterfaces",
+				"DeveloperSettings"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
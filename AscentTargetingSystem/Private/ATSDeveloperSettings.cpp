@@ -0,0 +1,3 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ATSDeveloperSettings.h"
@@ -0,0 +1,92 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ATSProjectionCache.h"
+#include "ATSStats.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projected Candidates"), STAT_ATSProjectedCandidates, STATGROUP_ATS);
+
+bool FATSProjectionCache::BeginFrame(const APlayerController* playerController)
+{
+    if (frame == GFrameCounter) {
+        return bHasView;
+    }
+
+    frame = GFrameCounter;
+    bHasView = false;
+    objects.Reset();
+    screenLocations.Reset();
+    entries.Reset();
+    bSorted = false;
+
+    const ULocalPlayer* localPlayer = playerController ? playerController->GetLocalPlayer() : nullptr;
+    if (!localPlayer || !localPlayer->ViewportClient || !localPlayer->ViewportClient->Viewport) {
+        return false;
+    }
+
+    // Split screen players project with their own view
+    FSceneViewProjectionData projectionData;
+    if (!localPlayer->GetProjectionData(localPlayer->ViewportClient->Viewport, projectionData)) {
+        return false;
+    }
+    viewProjection = projectionData.ComputeViewProjectionMatrix();
+    viewRect = projectionData.GetConstrainedViewRect();
+    bHasView = true;
+    return true;
+}
+
+int32 FATSProjectionCache::AddEntry(const UObject* object, const FVector& worldLocation)
+{
+    if (const int32* entry = entries.Find(object)) {
+        return *entry;
+    }
+
+    FVector2D screenLocation;
+    if (!ProjectLocation(worldLocation, screenLocation)) {
+        return INDEX_NONE;
+    }
+
+    INC_DWORD_STAT(STAT_ATSProjectedCandidates);
+    const int32 entry = objects.Add(const_cast<UObject*>(object));
+    screenLocations.Add(screenLocation);
+    entries.Add(object, entry);
+    bSorted = false;
+    return entry;
+}
+
+bool FATSProjectionCache::ProjectLocation(const FVector& worldLocation, FVector2D& outScreenLocation) const
+{
+    return bHasView && FSceneView::ProjectWorldToScreen(worldLocation, viewRect, viewProjection, outScreenLocation);
+}
+
+void FATSProjectionCache::GetEntriesInDirection(const FVector2D& screenOrigin, const bool bVerticalAxis, const bool bPositive, TArray<int32>& outEntries)
+{
+    outEntries.Reset();
+
+    if (!bSorted) {
+        sortedByX.Reset(screenLocations.Num());
+        for (int32 entry = 0; entry < screenLocations.Num(); entry++) {
+            sortedByX.Add(entry);
+        }
+        sortedByY = sortedByX;
+        sortedByX.Sort([this](const int32 a, const int32 b) { return screenLocations[a].X < screenLocations[b].X; });
+        sortedByY.Sort([this](const int32 a, const int32 b) { return screenLocations[a].Y < screenLocations[b].Y; });
+        bSorted = true;
+    }
+
+    const TArray<int32>& sorted = bVerticalAxis ? sortedByY : sortedByX;
+    const double originValue = bVerticalAxis ? screenOrigin.Y : screenOrigin.X;
+    const int32 split = Algo::LowerBoundBy(sorted, originValue, [this, bVerticalAxis](const int32 entry) {
+        return bVerticalAxis ? screenLocations[entry].Y : screenLocations[entry].X;
+    });
+
+    if (bPositive) {
+        outEntries.Append(sorted.GetData() + split, sorted.Num() - split);
+    } else {
+        outEntries.Append(sorted.GetData(), split);
+    }
+}
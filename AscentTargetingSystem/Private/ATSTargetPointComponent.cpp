@@ -1,6 +1,7 @@
 // Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved. 
 
 #include "ATSTargetPointComponent.h"
+#include "ATSTargetingSubsystem.h"
 #include <Engine/TargetPoint.h>
 #include <Engine/World.h>
 
@@ -14,4 +15,21 @@ UATSTargetPointComponent::UATSTargetPointComponent()
 	// ...
 }
 
+void UATSTargetPointComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Targeting components find the points of their target in the registry instead of enumerating its components
+	if (UATSTargetingSubsystem* targetingSubsystem = GetWorld()->GetSubsystem<UATSTargetingSubsystem>()) {
+		targetingSubsystem->RegisterTargetPoint(this);
+	}
+}
 
+void UATSTargetPointComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UATSTargetingSubsystem* targetingSubsystem = GetWorld()->GetSubsystem<UATSTargetingSubsystem>()) {
+		targetingSubsystem->UnregisterTargetPoint(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -3,10 +3,12 @@
 #include "ATSTargetingComponent.h"
 #include "ATSTargetPointComponent.h"
 #include "ATSTargetableInterface.h"
+#include "ATSTargetingSubsystem.h"
 #include "CCMCameraFunctionLibrary.h"
 #include "Interfaces/ACFEntityInterface.h"
 #include <Camera/PlayerCameraManager.h>
 #include <Components/ActorComponent.h>
+#include <Components/PrimitiveComponent.h>
 #include <Engine/World.h>
 #include <GameFramework/Actor.h>
 #include <GameFramework/Character.h>
@@ -34,6 +36,25 @@ void UATSTargetingComponent::BeginPlay()
     Super::BeginPlay();
     SetComponentTickEnabled(false);
     SetOwnerReferences();
+
+    // Targets that die or leave the world are dropped right away, whatever the update policy
+    if (UATSTargetingSubsystem* targetingSubsystem = GetWorld()->GetSubsystem<UATSTargetingSubsystem>()) {
+        targetUnregisteredHandle = targetingSubsystem->OnTargetUnregistered.AddUObject(this, &UATSTargetingComponent::HandleTargetLost);
+        targetDeathHandle = targetingSubsystem->OnTargetDeath.AddUObject(this, &UATSTargetingComponent::HandleTargetLost);
+    }
+}
+
+void UATSTargetingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UATSTargetingSubsystem* targetingSubsystem = GetWorld()->GetSubsystem<UATSTargetingSubsystem>()) {
+        targetingSubsystem->OnTargetUnregistered.Remove(targetUnregisteredHandle);
+        targetingSubsystem->OnTargetDeath.Remove(targetDeathHandle);
+        targetingSubsystem->UnscheduleTargetingUpdate(this);
+    }
+    targetUnregisteredHandle.Reset();
+    targetDeathHandle.Reset();
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void UATSTargetingComponent::ToggleTargeting()
@@ -46,11 +67,22 @@ void UATSTargetingComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+    RefreshTargeting(DeltaTime);
+}
+
+void UATSTargetingComponent::RefreshTargeting(float deltaTime)
+{
     if (!bCanTarget && Xvalue < deadband && YValue < deadband) {
         bCanTarget = true;
     }
 
-    UpdateTargeting(DeltaTime);
+    UpdateTargeting(deltaTime);
+}
+
+void UATSTargetingComponent::SetUpdatePolicy(ETargetingUpdatePolicy val)
+{
+    UpdatePolicy = val;
+    ApplyUpdatePolicy();
 }
 
 void UATSTargetingComponent::TriggerTargeting(bool bActivate)
@@ -69,6 +101,7 @@ void UATSTargetingComponent::AddFilter(TSubclassOf<UATSTargetingFilter> filterCl
 {
     UATSTargetingFilter* newFilter = NewObject<UATSTargetingFilter>(filterClass);
     TargetFilters.AddUnique(newFilter);
+    targetableCache.Reset();
 }
 
 void UATSTargetingComponent::AddObjectType(TEnumAsByte<EObjectTypeQuery> objectTypeToTrace)
@@ -96,6 +129,7 @@ bool UATSTargetingComponent::RemoveFilter(TSubclassOf<UATSTargetingFilter> filte
     }
     if (TargetFilters.IsValidIndex(index)) {
         TargetFilters.RemoveAt(index);
+        targetableCache.Reset();
         return true;
     }
     return false;
@@ -138,12 +172,12 @@ void UATSTargetingComponent::ActivateTargeting()
                     break;
                 }
             }
+        }
 
-            if (currentTarget) {
-                SetCurrentTarget(currentTarget);
-            } else {
-                UE_LOG(LogTemp, Warning, TEXT("No Availble Target"));
-            }
+        if (currentTarget) {
+            SetCurrentTarget(currentTarget);
+        } else {
+            UE_LOG(LogTemp, Warning, TEXT("No Availble Target"));
         }
     }
 }
@@ -151,107 +185,96 @@ void UATSTargetingComponent::ActivateTargeting()
 TArray<AActor*> UATSTargetingComponent::GetAllTargetsByDirection(ETargetingDirection direction)
 {
     TArray<AActor*> actorFilter;
-    for (AActor* target : availableTargets) {
-        if (target != CurrentTarget && IsValidTarget(target)) {
-            FVector PotentialTargetLocation = target->GetActorLocation();
+    if (!CurrentTarget || !projectionCache.BeginFrame(GetOwnerPlayerController())) {
+        return actorFilter;
+    }
 
-            if (!IsInFrontOfOwner(target)) {
-                continue;
-            }
-            switch (direction) {
-            case ETargetingDirection::ERight:
-                if (IsRightOfCurrentTarget(PotentialTargetLocation)) {
-                    actorFilter.AddUnique(target);
-                }
-                break;
-            case ETargetingDirection::ELeft:
-                if (!IsRightOfCurrentTarget(PotentialTargetLocation)) {
-                    actorFilter.AddUnique(target);
-                }
-                break;
-            case ETargetingDirection::EDown:
-                if (!IsUpOfCurrentTarget(PotentialTargetLocation)) {
-                    actorFilter.AddUnique(target);
-                }
-                break;
-            case ETargetingDirection::EUp:
-                if (IsUpOfCurrentTarget(PotentialTargetLocation)) {
-                    actorFilter.AddUnique(target);
-                }
-                break;
-            default:
-                break;
+    TSet<int32> candidates;
+    for (AActor* target : availableTargets) {
+        if (target != CurrentTarget && IsValidTarget(target) && IsInFrontOfOwner(target)) {
+            const int32 entry = projectionCache.AddEntry(target, target->GetActorLocation());
+            if (entry != INDEX_NONE) {
+                candidates.Add(entry);
             }
         }
     }
 
+    const UObject* currentKey = CurrentTargetPoint ? static_cast<UObject*>(CurrentTargetPoint) : CurrentTarget;
+    TArray<int32> entries;
+    GetEntriesInDirection(currentKey, GetCurrentTargetPointLocation(), candidates, direction, entries);
+    for (const int32 entry : entries) {
+        if (AActor* target = Cast<AActor>(projectionCache.GetObject(entry))) {
+            actorFilter.AddUnique(target);
+        }
+    }
+
     return actorFilter;
 }
 
 bool UATSTargetingComponent::TrySwitchPointOnCurrentTarget(ETargetingDirection direction)
 {
-    UATSTargetPointComponent* bestpoint = nullptr;
     TArray<UATSTargetPointComponent*> potentialTargets;
-    if (CurrentTarget && CurrentTargetPoint) {
-        TArray<UActorComponent*> points;
-        CurrentTarget->GetComponents(UATSTargetPointComponent::StaticClass(), points, true);
+    if (CurrentTarget && CurrentTargetPoint && projectionCache.BeginFrame(GetOwnerPlayerController())) {
+        TArray<UATSTargetPointComponent*> points;
+        GetTargetPoints(CurrentTarget, points);
         if (points.Num() > 1) {
-            for (auto point : points) {
-                UATSTargetPointComponent* targetpoint = Cast<UATSTargetPointComponent>(point);
-                if (targetpoint && targetpoint != CurrentTargetPoint) {
-                    FVector PotentialTargetLocation = targetpoint->GetComponentLocation();
-
-                    switch (direction) {
-                    case ETargetingDirection::ERight:
-                        if (IsRightOfCurrentTarget(PotentialTargetLocation)) {
-                            potentialTargets.Add(targetpoint);
-                        }
-                        break;
-                    case ETargetingDirection::ELeft:
-                        if (!IsRightOfCurrentTarget(PotentialTargetLocation)) {
-                            potentialTargets.Add(targetpoint);
-                        }
-                        break;
-                    case ETargetingDirection::EDown:
-                        if (!IsUpOfCurrentTarget(PotentialTargetLocation)) {
-                            potentialTargets.Add(targetpoint);
-                        }
-                        break;
-                    case ETargetingDirection::EUp:
-                        if (IsUpOfCurrentTarget(PotentialTargetLocation)) {
-                            potentialTargets.Add(targetpoint);
-                        }
-                        break;
-                    default:
-                        break;
+            TSet<int32> candidates;
+            for (UATSTargetPointComponent* targetpoint : points) {
+                if (targetpoint != CurrentTargetPoint) {
+                    const int32 entry = projectionCache.AddEntry(targetpoint, targetpoint->GetComponentLocation());
+                    if (entry != INDEX_NONE) {
+                        candidates.Add(entry);
                     }
                 }
             }
+
+            TArray<int32> entries;
+            GetEntriesInDirection(CurrentTargetPoint, CurrentTargetPoint->GetComponentLocation(), candidates, direction, entries);
+            for (const int32 entry : entries) {
+                if (UATSTargetPointComponent* targetpoint = Cast<UATSTargetPointComponent>(projectionCache.GetObject(entry))) {
+                    potentialTargets.Add(targetpoint);
+                }
+            }
         }
     }
 
     if (potentialTargets.Num() == 0) {
         return false;
-    } else {
-        UATSTargetPointComponent* finaltarget = GetNearestTargetPoint(potentialTargets);
-        UpdateCurrentTargetPoint(finaltarget);
     }
 
-    return false;
+    UATSTargetPointComponent* finaltarget = GetNearestTargetPoint(potentialTargets);
+    UpdateCurrentTargetPoint(finaltarget);
+    return true;
+}
+
+void UATSTargetingComponent::GetEntriesInDirection(const UObject* currentKey, const FVector& currentLocation, const TSet<int32>& candidates,
+    ETargetingDirection direction, TArray<int32>& outEntries)
+{
+    outEntries.Reset();
+    const int32 currentEntry = projectionCache.AddEntry(currentKey, currentLocation);
+    if (currentEntry == INDEX_NONE || candidates.Num() == 0) {
+        return;
+    }
+
+    // Screen Y grows downwards, Up keeps matching the targets with a greater Y as it always did
+    const bool bVerticalAxis = direction == ETargetingDirection::EUp || direction == ETargetingDirection::EDown;
+    const bool bPositive = direction == ETargetingDirection::ERight || direction == ETargetingDirection::EUp;
+    projectionCache.GetEntriesInDirection(projectionCache.GetScreenLocation(currentEntry), bVerticalAxis, bPositive, outEntries);
+
+    // The cache also holds the candidates of other queries of this frame
+    outEntries.RemoveAll([&candidates](const int32 entry) {
+        return !candidates.Contains(entry);
+    });
 }
 
 bool UATSTargetingComponent::IsRightOfCurrentTarget(FVector LocationToCheck)
 {
-    FVector CurrentTargetLocation = GetCurrentTargetPointLocation();
     FVector2D currentTargetLocationOnScreen;
     FVector2D potentialTargetLocationOnScreen;
 
-    APlayerController* playerController = UGameplayStatics::GetPlayerController(this, 0);
-
-    if (playerController) {
-        playerController->ProjectWorldLocationToScreen(CurrentTargetLocation, currentTargetLocationOnScreen);
-        playerController->ProjectWorldLocationToScreen(LocationToCheck, potentialTargetLocationOnScreen);
-
+    if (projectionCache.BeginFrame(GetOwnerPlayerController())
+        && projectionCache.ProjectLocation(GetCurrentTargetPointLocation(), currentTargetLocationOnScreen)
+        && projectionCache.ProjectLocation(LocationToCheck, potentialTargetLocationOnScreen)) {
         return (potentialTargetLocationOnScreen.X - currentTargetLocationOnScreen.X) >= 0;
     }
     return false;
@@ -259,16 +282,12 @@ bool UATSTargetingComponent::IsRightOfCurrentTarget(FVector LocationToCheck)
 
 bool UATSTargetingComponent::IsUpOfCurrentTarget(FVector LocationToCheck)
 {
-    FVector CurrentTargetLocation = GetCurrentTargetPointLocation();
     FVector2D currentTargetLocationOnScreen;
     FVector2D potentialTargetLocationOnScreen;
 
-    APlayerController* playerController = UGameplayStatics::GetPlayerController(this, 0);
-
-    if (playerController) {
-        playerController->ProjectWorldLocationToScreen(CurrentTargetLocation, currentTargetLocationOnScreen);
-        playerController->ProjectWorldLocationToScreen(LocationToCheck, potentialTargetLocationOnScreen);
-
+    if (projectionCache.BeginFrame(GetOwnerPlayerController())
+        && projectionCache.ProjectLocation(GetCurrentTargetPointLocation(), currentTargetLocationOnScreen)
+        && projectionCache.ProjectLocation(LocationToCheck, potentialTargetLocationOnScreen)) {
         return (potentialTargetLocationOnScreen.Y - currentTargetLocationOnScreen.Y) >= 0;
     }
     return false;
@@ -318,18 +337,101 @@ UATSTargetPointComponent* UATSTargetingComponent::GetNearestTargetPoint(TArray<U
 void UATSTargetingComponent::HandlePawnChanged(class APawn* newPawn)
 {
     ControlledPawn = newPawn;
+    ApplyUpdatePolicy();
+}
+
+void UATSTargetingComponent::HandleTargetLost(AActor* target)
+{
+    if (bIsTargeting && target && target == CurrentTarget) {
+        TriggerTargeting(false);
+    }
+}
+
+ETargetingUpdatePolicy UATSTargetingComponent::GetEffectiveUpdatePolicy() const
+{
+    if (UpdatePolicy != ETargetingUpdatePolicy::EAutomatic) {
+        return UpdatePolicy;
+    }
+    // Only the player looking through the camera needs the lock checked every frame
+    return IsOwnerLocallyControlled() ? ETargetingUpdatePolicy::EEveryFrame : ETargetingUpdatePolicy::EInterval;
+}
+
+void UATSTargetingComponent::ApplyUpdatePolicy()
+{
+    const ETargetingUpdatePolicy policy = GetEffectiveUpdatePolicy();
+    const bool bLocked = CurrentTarget != nullptr;
+    const UWorld* world = GetWorld();
+    UATSTargetingSubsystem* targetingSubsystem = world ? world->GetSubsystem<UATSTargetingSubsystem>() : nullptr;
+
+    // Without the subsystem nothing batches the updates, so interval components tick as well
+    const bool bTick = policy == ETargetingUpdatePolicy::EEveryFrame || (policy == ETargetingUpdatePolicy::EInterval && !targetingSubsystem);
+    SetComponentTickEnabled(bLocked && bTick);
+    if (!targetingSubsystem) {
+        return;
+    }
+
+    if (bLocked && policy == ETargetingUpdatePolicy::EInterval) {
+        targetingSubsystem->ScheduleTargetingUpdate(this, UpdateInterval);
+    } else {
+        targetingSubsystem->UnscheduleTargetingUpdate(this);
+    }
+}
+
+bool UATSTargetingComponent::IsOwnerLocallyControlled() const
+{
+    // AI controllers and the pawns of remote players never are, even when ownerController falls back to the first player
+    const AController* controller = Cast<AController>(GetOwner());
+    if (!controller) {
+        if (const APawn* pawnOwner = Cast<APawn>(GetOwner())) {
+            controller = pawnOwner->GetController();
+        }
+    }
+    if (controller) {
+        return controller->IsLocalPlayerController();
+    }
+    return ownerController.IsValid() && ownerController->IsLocalController();
 }
 
 bool UATSTargetingComponent::IsValidTarget(AActor* target)
 {
-    if (target && ControlledPawn && target != ControlledPawn) {
-        bool bImplements = target->GetClass()->ImplementsInterface(UATSTargetableInterface::StaticClass());
-        if (bImplements) {
-            for (UATSTargetingFilter* filter : TargetFilters) {
-                if (filter && !filter->IsActorTargetable(GetOwner(), target)) {
-                    return false;
-                }
+    if (!target || !ControlledPawn || target == ControlledPawn) {
+        return false;
+    }
+
+    if (targetableCacheFrame != GFrameCounter) {
+        targetableCache.Reset();
+        targetableCacheFrame = GFrameCounter;
+    }
+    if (const bool* bCachedTargetable = targetableCache.Find(target)) {
+        return *bCachedTargetable;
+    }
+
+    bool bTargetable = target->GetClass()->ImplementsInterface(UATSTargetableInterface::StaticClass());
+    if (bTargetable) {
+        for (UATSTargetingFilter* filter : TargetFilters) {
+            if (filter && !filter->IsActorTargetable(GetOwner(), target)) {
+                bTargetable = false;
+                break;
             }
+        }
+    }
+    targetableCache.Add(target, bTargetable);
+    return bTargetable;
+}
+
+bool UATSTargetingComponent::MatchesObjectsToQuery(const AActor* target) const
+{
+    if (ObjectsToQuery.Num() == 0) {
+        return true;
+    }
+
+    const UPrimitiveComponent* rootPrimitive = Cast<UPrimitiveComponent>(target->GetRootComponent());
+    if (!rootPrimitive) {
+        return false;
+    }
+    const ECollisionChannel objectType = rootPrimitive->GetCollisionObjectType();
+    for (const TEnumAsByte<EObjectTypeQuery>& objectToQuery : ObjectsToQuery) {
+        if (UEngineTypes::ConvertToCollisionChannel(objectToQuery) == objectType) {
             return true;
         }
     }
@@ -391,7 +493,7 @@ void UATSTargetingComponent::SetCurrentTarget(AActor* target)
     } else {
         UCCMCameraFunctionLibrary::StopLockingCameraOnActor(this);
     }
-    SetComponentTickEnabled(CurrentTarget != nullptr);
+    ApplyUpdatePolicy();
     SetTarget(CurrentTarget);
     OnTargetChanged.Broadcast(CurrentTarget);
 }
@@ -430,24 +532,43 @@ UATSTargetPointComponent* UATSTargetingComponent::GetBestTargetPointForTarget(AA
     UATSTargetPointComponent* bestpoint = nullptr;
     float maxDirection = -1.f;
     if (target) {
-        TArray<UActorComponent*> points;
-        target->GetComponents(UATSTargetPointComponent::StaticClass(), points, true);
+        TArray<UATSTargetPointComponent*> points;
+        GetTargetPoints(target, points);
+
+        // The point closest to the center of the screen, projected once per frame along with the switching candidates
+        if (points.Num() != 0 && projectionCache.BeginFrame(GetOwnerPlayerController())) {
+            const FVector2D viewCenter = projectionCache.GetViewCenter();
+            float minDistanceSquared = MAX_flt;
+            for (UATSTargetPointComponent* targetpoint : points) {
+                const int32 entry = projectionCache.AddEntry(targetpoint, targetpoint->GetComponentLocation());
+                if (entry == INDEX_NONE) {
+                    continue;
+                }
+                const float distanceSquared = FVector2D::DistSquared(projectionCache.GetScreenLocation(entry), viewCenter);
+                if (distanceSquared < minDistanceSquared) {
+                    bestpoint = targetpoint;
+                    minDistanceSquared = distanceSquared;
+                }
+            }
+            if (bestpoint) {
+                return bestpoint;
+            }
+        }
+
+        // Without a view, or with every point behind it, the camera direction picks the point
         FVector cameraForwardVector = UKismetMathLibrary::GetForwardVector(cameraManger->GetCameraRotation());
 
         cameraForwardVector.Z = 0;
         cameraForwardVector = cameraForwardVector.GetSafeNormal();
 
         if (points.Num() != 0) {
-            for (auto point : points) {
-                UATSTargetPointComponent* targetpoint = Cast<UATSTargetPointComponent>(point);
-                if (targetpoint) {
-                    FVector distance = targetpoint->GetComponentLocation() - ControlledPawn->GetActorLocation();
-                    distance = distance.GetUnsafeNormal();
-                    const float direction = FVector::DotProduct(cameraForwardVector, distance);
-                    if (direction > maxDirection) {
-                        bestpoint = targetpoint;
-                        maxDirection = direction;
-                    }
+            for (UATSTargetPointComponent* targetpoint : points) {
+                FVector distance = targetpoint->GetComponentLocation() - ControlledPawn->GetActorLocation();
+                distance = distance.GetUnsafeNormal();
+                const float direction = FVector::DotProduct(cameraForwardVector, distance);
+                if (direction > maxDirection) {
+                    bestpoint = targetpoint;
+                    maxDirection = direction;
                 }
             }
         }
@@ -456,6 +577,30 @@ UATSTargetPointComponent* UATSTargetingComponent::GetBestTargetPointForTarget(AA
     return bestpoint;
 }
 
+void UATSTargetingComponent::GetTargetPoints(const AActor* target, TArray<UATSTargetPointComponent*>& outPoints) const
+{
+    outPoints.Reset();
+    if (!target) {
+        return;
+    }
+
+    const UWorld* world = GetWorld();
+    const UATSTargetingSubsystem* targetingSubsystem = world ? world->GetSubsystem<UATSTargetingSubsystem>() : nullptr;
+    if (targetingSubsystem) {
+        if (const TArray<TWeakObjectPtr<UATSTargetPointComponent>>* points = targetingSubsystem->FindTargetPoints(target)) {
+            for (const TWeakObjectPtr<UATSTargetPointComponent>& point : *points) {
+                if (point.IsValid()) {
+                    outPoints.Add(point.Get());
+                }
+            }
+            return;
+        }
+    }
+
+    // Points that never began play, or were attached after they did, are only found on the components
+    target->GetComponents<UATSTargetPointComponent>(outPoints, true);
+}
+
 void UATSTargetingComponent::RightSearchTargetWithInput(float InputValue)
 {
     Xvalue = InputValue;
@@ -489,9 +634,19 @@ ELockType UATSTargetingComponent::GetLockTypeByTargetingType(ETargetingType targ
     return ELockType::EAllAxis;
 }
 
-void UATSTargetingComponent::PopulatePotentialTargetsArray()
+void UATSTargetingComponent::PopulatePotentialTargetsArray(const bool bInFrontOnly)
 {
     if (ControlledPawn) {
+        UWorld* world = GetWorld();
+        UATSTargetingSubsystem* targetingSubsystem = world ? world->GetSubsystem<UATSTargetingSubsystem>() : nullptr;
+        if (bUseTargetRegistry && targetingSubsystem) {
+            const FVector coneDirection = (bInFrontOnly && cameraManger) ? cameraManger->GetCameraRotation().Vector() : FVector::ZeroVector;
+            targetingSubsystem->QueryTargets(ControlledPawn->GetActorLocation(), GetMaxTargetingDistance(), coneDirection, GetMaxAngularDistanceDegree(), availableTargets);
+            availableTargets.RemoveAllSwap([this](const AActor* target) {
+                return target == ControlledPawn || !MatchesObjectsToQuery(target);
+            });
+            return;
+        }
 
         availableTargets.Empty();
         TArray<AActor*> ignoredActors;
@@ -509,7 +664,7 @@ void UATSTargetingComponent::SwitchTargetByDirection(ETargetingDirection directi
         return;
     }
 
-    PopulatePotentialTargetsArray();
+    PopulatePotentialTargetsArray(true);
     TArray<AActor*> actorFilter = GetAllTargetsByDirection(direction);
 
     AActor* localCurrentTarget = GetNearestTarget(actorFilter);
@@ -540,14 +695,33 @@ void UATSTargetingComponent::UpSearchTargetWithInput(float InputValue)
 
 void UATSTargetingComponent::SetOwnerReferences()
 {
-    ControlledPawn = UGameplayStatics::GetPlayerPawn(this, 0);
-
-    APlayerController* controller = UGameplayStatics::GetPlayerController(this, 0);
-    auto& eventNewPawn = controller->GetOnNewPawnNotifier();
-    eventNewPawn.AddLambda([this](APawn* newPawn) {
-        HandlePawnChanged(newPawn);
-    });
+    // Each local player targets with its own controller, the first player is only a fallback for unowned components
+    APlayerController* controller = Cast<APlayerController>(GetOwner());
+    if (!controller) {
+        if (const APawn* pawnOwner = Cast<APawn>(GetOwner())) {
+            controller = Cast<APlayerController>(pawnOwner->GetController());
+        }
+    }
+    if (!controller) {
+        controller = UGameplayStatics::GetPlayerController(this, 0);
+    }
 
-    cameraManger = UGameplayStatics::GetPlayerCameraManager(this, 0);
+    if (ownerController.Get() != controller) {
+        if (ownerController.IsValid()) {
+            ownerController->GetOnNewPawnNotifier().Remove(newPawnHandle);
+        }
+        newPawnHandle.Reset();
+        ownerController = controller;
+    }
     CurrentTarget = nullptr;
+    if (!controller) {
+        return;
+    }
+
+    ControlledPawn = controller->GetPawn();
+    if (!newPawnHandle.IsValid()) {
+        newPawnHandle = controller->GetOnNewPawnNotifier().AddUObject(this, &UATSTargetingComponent::HandlePawnChanged);
+    }
+    cameraManger = controller->PlayerCameraManager;
+    ApplyUpdatePolicy();
 }
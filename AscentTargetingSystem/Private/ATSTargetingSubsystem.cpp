@@ -0,0 +1,336 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#include "ATSTargetingSubsystem.h"
+#include "ATSDeveloperSettings.h"
+#include "ATSStats.h"
+#include "ATSTargetPointComponent.h"
+#include "ATSTargetingComponent.h"
+#include "ATSTargetableInterface.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Query"), STAT_ATSTargetQuery, STATGROUP_ATS);
+DECLARE_CYCLE_STAT(TEXT("Targeting Updates"), STAT_ATSTargetingUpdates, STATGROUP_ATS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Targets"), STAT_ATSRegisteredTargets, STATGROUP_ATS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scheduled Targeting Components"), STAT_ATSScheduledComponents, STATGROUP_ATS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Updated Targeting Components"), STAT_ATSUpdatedComponents, STATGROUP_ATS);
+
+void UATSTargetingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UWorld* world = GetWorld()) {
+        actorSpawnedHandle = world->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UATSTargetingSubsystem::HandleActorSpawned));
+    }
+    levelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UATSTargetingSubsystem::HandleLevelAdded);
+}
+
+void UATSTargetingSubsystem::Deinitialize()
+{
+    if (UWorld* world = GetWorld()) {
+        world->RemoveOnActorSpawnedHandler(actorSpawnedHandle);
+    }
+    FWorldDelegates::LevelAddedToWorld.Remove(levelAddedHandle);
+
+    targets.Reset();
+    targetIndices.Reset();
+    cells.Reset();
+    targetPoints.Reset();
+    scheduledUpdates.Reset();
+    scheduledIndices.Reset();
+    Super::Deinitialize();
+}
+
+void UATSTargetingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Actors placed in the map were never spawned
+    for (TActorIterator<AActor> It(&InWorld); It; ++It) {
+        TryRegisterActor(*It);
+    }
+}
+
+void UATSTargetingSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ATSTargetingUpdates);
+
+    const int32 numUpdates = scheduledUpdates.Num();
+    SET_DWORD_STAT(STAT_ATSScheduledComponents, numUpdates);
+    if (numUpdates == 0) {
+        return;
+    }
+
+    const UATSDeveloperSettings* settings = GetDefault<UATSDeveloperSettings>();
+    const int32 budget = settings->MaxTargetingUpdatesPerFrame > 0 ? FMath::Min(settings->MaxTargetingUpdatesPerFrame, numUpdates) : numUpdates;
+    const float now = GetWorld()->GetTimeSeconds();
+
+    // Components are only updated once the pass is over, as losing their target unschedules them
+    pendingUpdates.Reset();
+    for (int32 processed = 0; processed < budget; processed++) {
+        if (updateCursor >= numUpdates) {
+            updateCursor = 0;
+        }
+        FScheduledUpdate& update = scheduledUpdates[updateCursor++];
+
+        if (now < update.nextUpdateTime) {
+            continue;
+        }
+        pendingUpdates.Emplace(update.component, now - update.lastUpdateTime);
+        update.lastUpdateTime = now;
+        update.nextUpdateTime = now + update.interval;
+    }
+
+    INC_DWORD_STAT_BY(STAT_ATSUpdatedComponents, pendingUpdates.Num());
+    for (const auto& pendingUpdate : pendingUpdates) {
+        if (UATSTargetingComponent* targetingComp = pendingUpdate.Key.Get()) {
+            targetingComp->RefreshTargeting(pendingUpdate.Value);
+        }
+    }
+}
+
+TStatId UATSTargetingSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UATSTargetingSubsystem, STATGROUP_Tickables);
+}
+
+bool UATSTargetingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UATSTargetingSubsystem::RegisterTarget(AActor* target)
+{
+    if (!IsValid(target) || targetIndices.Contains(target)) {
+        return;
+    }
+
+    const int32 index = targets.Add({ target, target, target->GetActorLocation() });
+    targetIndices.Add(target, index);
+    target->OnEndPlay.AddUniqueDynamic(this, &UATSTargetingSubsystem::HandleTargetEndPlay);
+    bGridDirty = true;
+    SET_DWORD_STAT(STAT_ATSRegisteredTargets, targets.Num());
+}
+
+void UATSTargetingSubsystem::UnregisterTarget(AActor* target)
+{
+    const int32* index = targetIndices.Find(target);
+    if (!index) {
+        return;
+    }
+
+    if (target) {
+        target->OnEndPlay.RemoveDynamic(this, &UATSTargetingSubsystem::HandleTargetEndPlay);
+    }
+    RemoveTargetAt(*index);
+    OnTargetUnregistered.Broadcast(target);
+}
+
+void UATSTargetingSubsystem::NotifyTargetDeath(AActor* target)
+{
+    if (target) {
+        OnTargetDeath.Broadcast(target);
+    }
+}
+
+void UATSTargetingSubsystem::ScheduleTargetingUpdate(UATSTargetingComponent* targetingComp, const float interval)
+{
+    if (!targetingComp) {
+        return;
+    }
+
+    const float now = GetWorld()->GetTimeSeconds();
+    if (const int32* index = scheduledIndices.Find(targetingComp)) {
+        FScheduledUpdate& update = scheduledUpdates[*index];
+        update.nextUpdateTime = FMath::Min(update.nextUpdateTime, now + interval);
+        update.interval = interval;
+        return;
+    }
+
+    // The first check waits a full interval, the lock has just been validated by whoever set it
+    const int32 index = scheduledUpdates.Add({ targetingComp, targetingComp, interval, now, now + interval });
+    scheduledIndices.Add(targetingComp, index);
+}
+
+void UATSTargetingSubsystem::UnscheduleTargetingUpdate(UATSTargetingComponent* targetingComp)
+{
+    if (const int32* index = scheduledIndices.Find(targetingComp)) {
+        RemoveScheduledUpdateAt(*index);
+    }
+}
+
+void UATSTargetingSubsystem::RegisterTargetPoint(UATSTargetPointComponent* point)
+{
+    if (!point) {
+        return;
+    }
+
+    // Points on child actors, like weak points of a boss, also belong to every actor they are attached through
+    for (AActor* owner = point->GetOwner(); owner; owner = owner->GetParentActor()) {
+        TArray<TWeakObjectPtr<UATSTargetPointComponent>>& points = targetPoints.FindOrAdd(owner);
+        if (points.Contains(point)) {
+            continue;
+        }
+        points.RemoveAll([](const TWeakObjectPtr<UATSTargetPointComponent>& registered) {
+            return !registered.IsValid();
+        });
+        points.Add(point);
+
+        // Same order whatever the order the points began play in, so ties between points are always broken the same way
+        points.Sort([](const TWeakObjectPtr<UATSTargetPointComponent>& a, const TWeakObjectPtr<UATSTargetPointComponent>& b) {
+            return a->GetFName().LexicalLess(b->GetFName());
+        });
+    }
+}
+
+void UATSTargetingSubsystem::UnregisterTargetPoint(UATSTargetPointComponent* point)
+{
+    if (!point) {
+        return;
+    }
+
+    for (AActor* owner = point->GetOwner(); owner; owner = owner->GetParentActor()) {
+        TArray<TWeakObjectPtr<UATSTargetPointComponent>>* points = targetPoints.Find(owner);
+        if (!points) {
+            continue;
+        }
+
+        points->RemoveAll([point](const TWeakObjectPtr<UATSTargetPointComponent>& registered) {
+            return !registered.IsValid() || registered.Get() == point;
+        });
+        if (points->Num() == 0) {
+            targetPoints.Remove(owner);
+        }
+    }
+}
+
+void UATSTargetingSubsystem::QueryTargets(const FVector& origin, const float radius, const FVector& direction, const float maxAngleDegree, TArray<AActor*>& outTargets)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ATSTargetQuery);
+
+    outTargets.Reset();
+    RefreshGrid();
+
+    const bool bCheckCone = maxAngleDegree < 180.f && !direction.IsNearlyZero();
+    const FVector coneDirection = direction.GetSafeNormal();
+    const float minDot = FMath::Cos(FMath::DegreesToRadians(maxAngleDegree));
+    const float radiusSquared = radius * radius;
+
+    const FIntPoint minCell = GetCell(origin - FVector(radius));
+    const FIntPoint maxCell = GetCell(origin + FVector(radius));
+    for (int32 x = minCell.X; x <= maxCell.X; x++) {
+        for (int32 y = minCell.Y; y <= maxCell.Y; y++) {
+            const TArray<int32>* cell = cells.Find(FIntPoint(x, y));
+            if (!cell) {
+                continue;
+            }
+
+            for (const int32 index : *cell) {
+                const FRegisteredTarget& target = targets[index];
+                AActor* actor = target.actor.Get();
+                if (!actor || actor->IsPendingKillPending()) {
+                    continue;
+                }
+
+                const FVector offset = target.location - origin;
+                const float distanceSquared = offset.SizeSquared();
+                if (distanceSquared > radiusSquared) {
+                    continue;
+                }
+                if (bCheckCone && distanceSquared > KINDA_SMALL_NUMBER && FVector::DotProduct(offset * FMath::InvSqrt(distanceSquared), coneDirection) < minDot) {
+                    continue;
+                }
+                outTargets.Add(actor);
+            }
+        }
+    }
+}
+
+void UATSTargetingSubsystem::RefreshGrid()
+{
+    // Targets move, but queries come from lock-on and switching only, so the grid is rebuilt lazily
+    if (!bGridDirty && gridFrame == GFrameCounter) {
+        return;
+    }
+    gridFrame = GFrameCounter;
+
+    for (TPair<FIntPoint, TArray<int32>>& cell : cells) {
+        cell.Value.Reset();
+    }
+
+    for (int32 index = targets.Num() - 1; index >= 0; index--) {
+        if (!targets[index].actor.IsValid()) {
+            RemoveTargetAt(index);
+        }
+    }
+
+    for (int32 index = 0; index < targets.Num(); index++) {
+        FRegisteredTarget& target = targets[index];
+        target.location = target.actor->GetActorLocation();
+        cells.FindOrAdd(GetCell(target.location)).Add(index);
+    }
+
+    // Cells keep their allocation while targets stay around, the ones left behind are dropped
+    for (auto cell = cells.CreateIterator(); cell; ++cell) {
+        if (cell->Value.Num() == 0) {
+            cell.RemoveCurrent();
+        }
+    }
+
+    // Cleared last, removing the stale targets above dirties the grid again
+    bGridDirty = false;
+}
+
+FIntPoint UATSTargetingSubsystem::GetCell(const FVector& location) const
+{
+    return FIntPoint(FMath::FloorToInt(location.X / cellSize), FMath::FloorToInt(location.Y / cellSize));
+}
+
+void UATSTargetingSubsystem::RemoveTargetAt(const int32 index)
+{
+    targetIndices.Remove(targets[index].key);
+    targets.RemoveAtSwap(index);
+    if (targets.IsValidIndex(index)) {
+        targetIndices.Add(targets[index].key, index);
+    }
+    bGridDirty = true;
+    SET_DWORD_STAT(STAT_ATSRegisteredTargets, targets.Num());
+}
+
+void UATSTargetingSubsystem::RemoveScheduledUpdateAt(const int32 index)
+{
+    scheduledIndices.Remove(scheduledUpdates[index].key);
+    scheduledUpdates.RemoveAtSwap(index);
+    if (scheduledUpdates.IsValidIndex(index)) {
+        scheduledIndices.Add(scheduledUpdates[index].key, index);
+    }
+}
+
+void UATSTargetingSubsystem::TryRegisterActor(AActor* actor)
+{
+    if (IsValid(actor) && actor->GetClass()->ImplementsInterface(UATSTargetableInterface::StaticClass())) {
+        RegisterTarget(actor);
+    }
+}
+
+void UATSTargetingSubsystem::HandleActorSpawned(AActor* actor)
+{
+    TryRegisterActor(actor);
+}
+
+void UATSTargetingSubsystem::HandleLevelAdded(ULevel* level, UWorld* world)
+{
+    if (!level || world != GetWorld()) {
+        return;
+    }
+    for (AActor* actor : level->Actors) {
+        TryRegisterActor(actor);
+    }
+}
+
+void UATSTargetingSubsystem::HandleTargetEndPlay(AActor* actor, EEndPlayReason::Type endPlayReason)
+{
+    UnregisterTarget(actor);
+}
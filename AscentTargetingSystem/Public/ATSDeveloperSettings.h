@@ -0,0 +1,22 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "ATSDeveloperSettings.generated.h"
+
+/**
+ *
+ */
+UCLASS(config = Plugins, defaultconfig, meta = (DisplayName = "Ascent Targeting System"))
+class ASCENTTARGETINGSYSTEM_API UATSDeveloperSettings : public UDeveloperSettings {
+    GENERATED_BODY()
+
+public:
+    /*Max amount of scheduled targeting components checked in a single frame, the remaining ones
+        are checked in the following frames. 0 means no limit*/
+    UPROPERTY(EditAnywhere, config, meta = (ClampMin = 0), Category = "ATS | Update")
+    int32 MaxTargetingUpdatesPerFrame = 64;
+};
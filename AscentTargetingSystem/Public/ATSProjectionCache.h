@@ -0,0 +1,66 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerController;
+
+/**
+ * Screen locations of the targeting candidates of one local player. The view projection of the player
+ * is fetched once per frame, and each candidate is projected the first time it is requested in that frame.
+ * Directional queries are answered by binary search on the candidates sorted along each screen axis.
+ */
+class ASCENTTARGETINGSYSTEM_API FATSProjectionCache {
+
+public:
+    /*Refreshes the view projection on the first call of a frame. False if the player has no view to project on*/
+    bool BeginFrame(const APlayerController* playerController);
+
+    /*Projects the location of object once per frame, returns its entry or INDEX_NONE if it is behind the view*/
+    int32 AddEntry(const UObject* object, const FVector& worldLocation);
+
+    /*Projects a location that is not a candidate, with the view projection of the frame*/
+    bool ProjectLocation(const FVector& worldLocation, FVector2D& outScreenLocation) const;
+
+    const FVector2D& GetScreenLocation(const int32 entry) const
+    {
+        return screenLocations[entry];
+    }
+
+    /*Center of the view of the frame, in the same space as the screen locations*/
+    FVector2D GetViewCenter() const
+    {
+        return FVector2D(viewRect.Min) + FVector2D(viewRect.Size()) * 0.5f;
+    }
+
+    UObject* GetObject(const int32 entry) const
+    {
+        return objects[entry].Get();
+    }
+
+    /*Entries at or past screenOrigin along the axis when bPositive, strictly before it otherwise*/
+    void GetEntriesInDirection(const FVector2D& screenOrigin, const bool bVerticalAxis, const bool bPositive, TArray<int32>& outEntries);
+
+private:
+    uint64 frame = 0;
+
+    bool bHasView = false;
+
+    FMatrix viewProjection;
+
+    FIntRect viewRect;
+
+    TArray<TWeakObjectPtr<UObject>> objects;
+
+    TArray<FVector2D> screenLocations;
+
+    TMap<TObjectKey<UObject>, int32> entries;
+
+    // Entries sorted by screen X and Y, rebuilt when a directional query follows new entries
+    TArray<int32> sortedByX;
+
+    TArray<int32> sortedByY;
+
+    bool bSorted = false;
+};
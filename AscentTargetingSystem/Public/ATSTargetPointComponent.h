@@ -26,6 +26,10 @@ public:
 
 protected:
 
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/*The camera event triggered when this point gets targeted*/
 	UPROPERTY(EditDefaultsOnly, Category = ATS)
 	FName CameraEvent;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ATSBaseTargetComponent.h"
+#include "ATSProjectionCache.h"
 #include "ATSTargetingFilter.h"
 #include "CCMTypes.h"
 #include "Components/ActorComponent.h"
@@ -12,6 +13,7 @@
 #include "ATSTargetingComponent.generated.h"
 
 class APlayerCameraManager;
+class APlayerController;
 class APawn;
 class AActor;
 
@@ -39,6 +41,14 @@ enum class ETargetSelectionType : uint8 {
     EForwardTarget = 1 UMETA(DisplayName = "Choose Lower Degrees From Forward"),
 };
 
+UENUM(BlueprintType)
+enum class ETargetingUpdatePolicy : uint8 {
+    EAutomatic = 0 UMETA(DisplayName = "Every Frame If Locally Controlled, Interval Otherwise"),
+    EEveryFrame UMETA(DisplayName = "Every Frame"),
+    EInterval UMETA(DisplayName = "Every Update Interval"),
+    EEventDriven UMETA(DisplayName = "Only On Target Death Or Unregister"),
+};
+
 UCLASS(ClassGroup = (ATS), Blueprintable, meta = (BlueprintSpawnableComponent))
 class ASCENTTARGETINGSYSTEM_API UATSTargetingComponent : public UATSBaseTargetComponent {
     GENERATED_BODY()
@@ -51,6 +61,8 @@ protected:
     // Called when the game starts
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /*InputThrashold to start looking for targets with input*/
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = ATS)
     float InputTrasholdForSearch = .7f;
@@ -88,9 +100,15 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = ATS)
     float UpperPitchLimitDegree = 75.f;
 
+    /*Object types of the potential targets. With the target registry, the collision object type of the target root component
+    is checked against them, an empty list accepts any targetable actor*/
     UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = ATS)
     TArray<TEnumAsByte<EObjectTypeQuery>> ObjectsToQuery;
 
+    /*Looks for potential targets in the UATSTargetingSubsystem registry instead of a sphere overlap*/
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = ATS)
+    bool bUseTargetRegistry = true;
+
     /*Filters to avoid an acotr from being targeted*/
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Instanced, Category = ATS)
     TArray<class UATSTargetingFilter*> TargetFilters;
@@ -99,10 +117,28 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = ATS)
     bool bStopTargetingIfOutOfSight = true;
 
+    /*How often the distance, sight and health of the current target are checked while locked.
+    Whatever the policy, the lock is dropped as soon as the target dies or leaves the target registry*/
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ATS | Update")
+    ETargetingUpdatePolicy UpdatePolicy = ETargetingUpdatePolicy::EAutomatic;
+
+    /*Seconds between two checks of the current target, when they are not done every frame*/
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = 0), Category = "ATS | Update")
+    float UpdateInterval = .25f;
+
 public:
     // Called every frame
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+    /*Checks that the current target can still be locked, called on tick or by the targeting subsystem depending on UpdatePolicy*/
+    void RefreshTargeting(float deltaTime);
+
+    UFUNCTION(BlueprintPure, Category = ATS)
+    ETargetingUpdatePolicy GetUpdatePolicy() const { return UpdatePolicy; }
+
+    UFUNCTION(BlueprintCallable, Category = ATS)
+    void SetUpdatePolicy(ETargetingUpdatePolicy val);
+
     UFUNCTION(BlueprintPure, Category = ATS)
     float GetLockMagnetism() const { return LockMagnetism; }
 
@@ -168,9 +204,16 @@ public:
 
     virtual void SetCurrentTarget(AActor* target) override;
 
+    /*Binds the component to the player controller that owns it, directly or through its pawn*/
     UFUNCTION(BlueprintCallable, Category = ATS)
     void SetOwnerReferences();
 
+    UFUNCTION(BlueprintPure, Category = ATS)
+    APlayerController* GetOwnerPlayerController() const
+    {
+        return ownerController.Get();
+    }
+
     UPROPERTY(BlueprintAssignable, Category = ATS)
     FOnTargetingStateChanged OnTargetingStateChanged;
 
@@ -180,7 +223,8 @@ public:
 private:
     ELockType GetLockTypeByTargetingType(ETargetingType targetType);
 
-    void PopulatePotentialTargetsArray();
+    /*With bInFrontOnly, the registry also discards the targets outside MaxAngularDistanceDegree from the camera*/
+    void PopulatePotentialTargetsArray(const bool bInFrontOnly = false);
 
     void SwitchTargetByDirection(ETargetingDirection direction);
 
@@ -189,6 +233,16 @@ private:
     UFUNCTION()
     void HandlePawnChanged(class APawn* newPawn);
 
+    void HandleTargetLost(AActor* target);
+
+    /*The policy that applies to this owner, EAutomatic is never returned*/
+    ETargetingUpdatePolicy GetEffectiveUpdatePolicy() const;
+
+    /*Ticks, schedules or stops updating the component for the current target and policy*/
+    void ApplyUpdatePolicy();
+
+    bool IsOwnerLocallyControlled() const;
+
     UFUNCTION()
     void ActivateTargeting();
 
@@ -204,6 +258,8 @@ private:
     UFUNCTION()
     bool IsValidTarget(AActor* target);
 
+    bool MatchesObjectsToQuery(const AActor* target) const;
+
     bool IsInFrontOfOwner(AActor* target);
 
     UFUNCTION()
@@ -217,6 +273,9 @@ private:
     UFUNCTION()
     class UATSTargetPointComponent* GetBestTargetPointForTarget(AActor* target);
 
+    /*Points registered in the targeting subsystem, the components of the target otherwise*/
+    void GetTargetPoints(const AActor* target, TArray<UATSTargetPointComponent*>& outPoints) const;
+
     UFUNCTION()
     bool IsRightOfCurrentTarget(FVector locationToCheck);
 
@@ -228,6 +287,11 @@ private:
     UPROPERTY()
     TArray<AActor*> availableTargets;
 
+    // Filter results of the current frame, so that a candidate is checked once per activation or switch
+    TMap<TObjectKey<AActor>, bool> targetableCache;
+
+    uint64 targetableCacheFrame = 0;
+
     TObjectPtr<APawn> ControlledPawn;
 
     bool bCanTarget = true;
@@ -240,4 +304,19 @@ private:
     bool bIsTargeting = false;
 
     TObjectPtr<APlayerCameraManager> cameraManger;
+
+    TWeakObjectPtr<APlayerController> ownerController;
+
+    FDelegateHandle newPawnHandle;
+
+    FDelegateHandle targetUnregisteredHandle;
+
+    FDelegateHandle targetDeathHandle;
+
+    // Screen locations of the candidates of the owning player, for directional switching
+    FATSProjectionCache projectionCache;
+
+    /*Candidates among entries that lie in direction from the current target on the screen of the owning player*/
+    void GetEntriesInDirection(const UObject* currentKey, const FVector& currentLocation, const TSet<int32>& candidates,
+        ETargetingDirection direction, TArray<int32>& outEntries);
 };
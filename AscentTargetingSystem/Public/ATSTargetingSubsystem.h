@@ -0,0 +1,161 @@
+// Copyright (C) Developed by Pask, Published by Dark Tower Interactive SRL 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ATSTargetingSubsystem.generated.h"
+
+class AActor;
+class ULevel;
+class UATSTargetPointComponent;
+class UATSTargetingComponent;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnATSTargetEvent, AActor*);
+
+/**
+ * Registry of the targetable actors of a world, bucketed in a uniform grid on the XY plane.
+ * Actors implementing IATSTargetableInterface are registered when they are spawned or streamed in
+ * and removed when they end play, so targeting components find candidates without physics overlaps.
+ * It also updates the targeting components that don't validate their lock every frame, within a per-frame budget.
+ */
+UCLASS()
+class ASCENTTARGETINGSYSTEM_API UATSTargetingSubsystem : public UTickableWorldSubsystem {
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    virtual void Deinitialize() override;
+
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override;
+
+    /*Targetable actors are registered automatically, this is only needed for the ones that are not spawned normally*/
+    UFUNCTION(BlueprintCallable, Category = ATS)
+    void RegisterTarget(AActor* target);
+
+    /*Removes the actor from the candidates of every targeting component, those locked on it lose it*/
+    UFUNCTION(BlueprintCallable, Category = ATS)
+    void UnregisterTarget(AActor* target);
+
+    UFUNCTION(BlueprintPure, Category = ATS)
+    bool IsTargetRegistered(const AActor* target) const
+    {
+        return targetIndices.Contains(target);
+    }
+
+    UFUNCTION(BlueprintPure, Category = ATS)
+    int32 GetNumTargets() const
+    {
+        return targets.Num();
+    }
+
+    /*Registered targets within radius of the origin and, if maxAngleDegree is below 180, within that angle of direction*/
+    void QueryTargets(const FVector& origin, const float radius, const FVector& direction, const float maxAngleDegree, TArray<AActor*>& outTargets);
+
+    /*Called by target points when they begin play, registers them with their owner and the actors it is a child actor of.
+    Keeps the points of each actor sorted by name*/
+    void RegisterTargetPoint(UATSTargetPointComponent* point);
+
+    void UnregisterTargetPoint(UATSTargetPointComponent* point);
+
+    /*Target points of the actor and of its child actors, nullptr if none has been registered*/
+    const TArray<TWeakObjectPtr<UATSTargetPointComponent>>* FindTargetPoints(const AActor* target) const
+    {
+        return targetPoints.Find(target);
+    }
+
+    /*Lets the targeting components locked on the target drop it without polling its health*/
+    UFUNCTION(BlueprintCallable, Category = ATS)
+    void NotifyTargetDeath(AActor* target);
+
+    /*Updates the component every interval seconds of game time, until it is unscheduled*/
+    void ScheduleTargetingUpdate(UATSTargetingComponent* targetingComp, const float interval);
+
+    void UnscheduleTargetingUpdate(UATSTargetingComponent* targetingComp);
+
+    /*Broadcast whenever a target leaves the registry*/
+    FOnATSTargetEvent OnTargetUnregistered;
+
+    /*Broadcast when a target notifies its death, it stays registered as it can be revived*/
+    FOnATSTargetEvent OnTargetDeath;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FRegisteredTarget {
+        TWeakObjectPtr<AActor> actor;
+
+        // Still valid once the actor is gone, to drop it from targetIndices
+        TObjectKey<AActor> key;
+
+        FVector location;
+    };
+
+    TArray<FRegisteredTarget> targets;
+
+    TMap<TObjectKey<AActor>, int32> targetIndices;
+
+    // Indices in targets, rebuilt at most once per frame and only when queried
+    TMap<FIntPoint, TArray<int32>> cells;
+
+    struct FScheduledUpdate {
+        TWeakObjectPtr<UATSTargetingComponent> component;
+
+        TObjectKey<UATSTargetingComponent> key;
+
+        float interval;
+
+        // Game time, in seconds
+        float lastUpdateTime;
+
+        float nextUpdateTime;
+    };
+
+    TArray<FScheduledUpdate> scheduledUpdates;
+
+    TMap<TObjectKey<UATSTargetingComponent>, int32> scheduledIndices;
+
+    // Next update to check, large populations are spread across frames
+    int32 updateCursor = 0;
+
+    TArray<TPair<TWeakObjectPtr<UATSTargetingComponent>, float>> pendingUpdates;
+
+    // Only changes when points begin or end play
+    TMap<TObjectKey<AActor>, TArray<TWeakObjectPtr<UATSTargetPointComponent>>> targetPoints;
+
+    uint64 gridFrame = 0;
+
+    bool bGridDirty = true;
+
+    // Wide enough that a lock-on query only touches a handful of cells
+    float cellSize = 1000.f;
+
+    FDelegateHandle actorSpawnedHandle;
+
+    FDelegateHandle levelAddedHandle;
+
+    void RefreshGrid();
+
+    FIntPoint GetCell(const FVector& location) const;
+
+    void RemoveTargetAt(const int32 index);
+
+    void RemoveScheduledUpdateAt(const int32 index);
+
+    void TryRegisterActor(AActor* actor);
+
+    void HandleActorSpawned(AActor* actor);
+
+    void HandleLevelAdded(ULevel* level, UWorld* world);
+
+    UFUNCTION()
+    void HandleTargetEndPlay(AActor* actor, EEndPlayReason::Type endPlayReason);
+};
@@ -3,6 +3,7 @@
 #include "ACMCollisionManagerComponent.h"
 #include "ACMCollisionsFunctionLibrary.h"
 #include "ACMCollisionsMasterComponent.h"
+#include "ACMStats.h"
 #include "ACMTypes.h"
 #include "Components/ActorComponent.h"
 #include "DrawDebugHelpers.h"
@@ -13,13 +14,17 @@
 #include <Components/ActorComponent.h>
 #include <Components/MeshComponent.h>
 #include <Components/SceneComponent.h>
+#include <Components/SkinnedMeshComponent.h>
+#include <Components/StaticMeshComponent.h>
 #include <Engine/EngineTypes.h>
+#include <Engine/StaticMeshSocket.h>
 #include <Engine/World.h>
 #include <GameFramework/Actor.h>
 #include <GameFramework/GameMode.h>
 #include <GameFramework/GameModeBase.h>
 #include <Kismet/GameplayStatics.h>
 #include <Kismet/KismetSystemLibrary.h>
+#include <Misc/App.h>
 #include <Particles/ParticleSystemComponent.h>
 #include <Sound/SoundBase.h>
 #include <Sound/SoundCue.h>
@@ -27,6 +32,10 @@
 #include <TimerManager.h>
 #include <WorldCollision.h>
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Trail Pool Hits"), STAT_ACMTrailPoolHits, STATGROUP_ACMCollisions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Trail Pool Misses"), STAT_ACMTrailPoolMisses, STATGROUP_ACMCollisions);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Trail Pool Components"), STAT_ACMTrailPoolComponents, STATGROUP_ACMCollisions);
+
 // Sets default values for this component's properties
 UACMCollisionManagerComponent::UACMCollisionManagerComponent()
 {
@@ -51,6 +60,28 @@ void UACMCollisionManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayRe
 }
 
 void UACMCollisionManagerComponent::UpdateCollisions()
+{
+    TArray<FACMSweepRequest> requests;
+    GatherSweepRequests(requests);
+
+    const UWorld* world = GetWorld();
+    if (!world) {
+        return;
+    }
+
+    // Sweep everything before resolving, resolving a hit can activate new traces
+    TArray<FACMSweepResult> results;
+    results.SetNum(requests.Num());
+    for (int32 index = 0; index < requests.Num(); index++) {
+        results[index].bHit = UACMCollisionsMasterComponent::PerformSweep(world, requests[index], results[index].HitResult);
+    }
+
+    for (int32 index = 0; index < requests.Num(); index++) {
+        ResolveSweepRequest(requests[index], results[index]);
+    }
+}
+
+void UACMCollisionManagerComponent::GatherSweepRequests(TArray<FACMSweepRequest>& outRequests)
 {
     if (damageMesh) {
         DisplayDebugTraces();
@@ -61,7 +92,11 @@ void UACMCollisionManagerComponent::UpdateCollisions()
                 if (activatedTraces.Contains(toDelete)) {
                     activatedTraces.Remove(toDelete);
                 }
-                alreadyHitActors.Remove(toDelete);
+                compiledTraces.Remove(toDelete);
+                FHitActors* alreadyHit = alreadyHitActors.Find(toDelete);
+                if (alreadyHit) {
+                    alreadyHit->Reset();
+                }
             }
             pendingDelete.Empty();
         }
@@ -70,75 +105,49 @@ void UACMCollisionManagerComponent::UpdateCollisions()
             return;
         }
         if (CollisionChannels.IsValidIndex(0)) {
-            for (TPair<FName, FTraceInfo>& currentTrace : activatedTraces) {
-                if (damageMesh->DoesSocketExist(currentTrace.Value.StartSocket) && damageMesh->DoesSocketExist(currentTrace.Value.EndSocket)) {
-                    FHitResult hitRes;
+            const UObject* meshAsset = GetDamageMeshAsset();
+            const USkinnedMeshComponent* skinnedMesh = Cast<USkinnedMeshComponent>(damageMesh);
+            const TArray<FTransform>* spaceTransforms = skinnedMesh ? &skinnedMesh->GetComponentSpaceTransforms() : nullptr;
+            const FTransform& componentToWorld = damageMesh->GetComponentTransform();
 
-                    const FVector StartPos = damageMesh->GetSocketLocation(currentTrace.Value.StartSocket);
-                    const FVector EndPos = damageMesh->GetSocketLocation(currentTrace.Value.EndSocket);
-                    const FRotator orientation = GetLineRotation(StartPos, EndPos);
-                    FCollisionQueryParams Params;
-
-                    if (IgnoredActors.Num() > 0) {
-                        Params.AddIgnoredActors(IgnoredActors);
-                    }
-
-                    if (bIgnoreOwner) {
-                        Params.AddIgnoredActor(GetActorOwner());
-                        Params.AddIgnoredActor(GetOwner());
-                    }
-
-                    Params.bReturnPhysicalMaterial = true;
-                    Params.bTraceComplex = true;
-
-                    FCollisionObjectQueryParams ObjectParams;
-                    for (const TEnumAsByte<ECollisionChannel>& channel : CollisionChannels) {
-                        if (ObjectParams.IsValidObjectQuery(channel)) {
-                            ObjectParams.AddObjectTypesToQuery(channel);
-                        }
-                    }
-
-                    if (!bAllowMultipleHitsPerSwing) {
-                        FHitActors* hitResact = alreadyHitActors.Find(currentTrace.Key);
-                        if (hitResact && hitResact->AlreadyHitActors.Num() > 0) {
-                            Params.AddIgnoredActors(hitResact->AlreadyHitActors);
-                        }
-                    }
+            for (TPair<FName, FTraceInfo>& currentTrace : activatedTraces) {
+                // Compiled traces are only added on activation, so the pointers handed to the
+                // sweep requests stay valid until the batch has been swept
+                FACMCompiledTrace* compiledTrace = compiledTraces.Find(currentTrace.Key);
+                if (!compiledTrace) {
+                    continue;
+                }
+                FACMCompiledTrace& compiled = *compiledTrace;
+                if (compiled.Mesh.Get() != damageMesh || compiled.MeshAsset.Get() != meshAsset) {
+                    CompileTraceSockets(currentTrace.Value, compiled);
+                }
+                if (compiled.IgnoreSetVersion != ignoreSetVersion) {
+                    CompileTraceQuery(currentTrace.Key, compiled);
+                }
 
-                    if (ObjectParams.IsValid() == false) {
+                if (compiled.bValidSockets) {
+                    if (compiled.bValidQuery == false) {
                         UE_LOG(LogTemp, Warning, TEXT("Invalid Collision Channel - UACMCollisionManagerComponent::UpdateCollisions()"));
                         return;
                     }
 
-                    UWorld* world = GetWorld();
-                    if (world) {
-                        bool bHit = world->SweepSingleByObjectType(
-                            hitRes, StartPos, EndPos, orientation.Quaternion(), ObjectParams, FCollisionShape::MakeSphere(currentTrace.Value.Radius), Params);
-
-                        if (!bHit && currentTrace.Value.bCrossframeAccuracy && !currentTrace.Value.bIsFirstFrame) {
-                            const FRotator oldOrient = GetLineRotation(StartPos, EndPos);
-                            bHit = world->SweepSingleByObjectType(
-                                hitRes, StartPos, currentTrace.Value.oldEndSocketPos, oldOrient.Quaternion(), ObjectParams, FCollisionShape::MakeSphere(currentTrace.Value.Radius), Params);
-                        }
-                        if (bHit) {
-                            OnCollisionDetected.Broadcast(hitRes);
-                            if (!bAllowMultipleHitsPerSwing) {
-                                FHitActors* hitResact = alreadyHitActors.Find(currentTrace.Key);
-                                if (hitResact) {
-                                    hitResact->AlreadyHitActors.Add(hitRes.GetActor());
-                                } else {
-                                    FHitActors newHit;
-                                    newHit.AlreadyHitActors.Add(hitRes.GetActor());
-                                    alreadyHitActors.Add(currentTrace.Key, newHit);
-                                }
-                            }
-                            ApplyDamage(hitRes, currentTrace.Value);
-                        }
-                        currentTrace.Value.bIsFirstFrame = false;
-                        currentTrace.Value.oldEndSocketPos = EndPos;
-                    }
-                } else {
-                    UE_LOG(LogTemp, Warning, TEXT("Invalid Socket Names!! - UACMCollisionManagerComponent::UpdateCollisions()"));
+                    const FVector StartPos = GetCompiledSocketLocation(compiled.StartSocket, spaceTransforms, componentToWorld);
+                    const FVector EndPos = GetCompiledSocketLocation(compiled.EndSocket, spaceTransforms, componentToWorld);
+
+                    FACMSweepRequest& request = outRequests.AddDefaulted_GetRef();
+                    request.Instigator = this;
+                    request.TraceName = currentTrace.Key;
+                    request.StartPos = StartPos;
+                    request.EndPos = EndPos;
+                    request.OldEndPos = currentTrace.Value.oldEndSocketPos;
+                    request.Orientation = GetLineRotation(StartPos, EndPos).Quaternion();
+                    request.Radius = currentTrace.Value.Radius;
+                    request.bCrossframe = currentTrace.Value.bCrossframeAccuracy && !currentTrace.Value.bIsFirstFrame;
+                    request.Params = &compiled.Params;
+                    request.ObjectParams = &compiled.ObjectParams;
+
+                    currentTrace.Value.bIsFirstFrame = false;
+                    currentTrace.Value.oldEndSocketPos = EndPos;
                 }
             }
         } else {
@@ -147,6 +156,152 @@ void UACMCollisionManagerComponent::UpdateCollisions()
     }
 }
 
+const UObject* UACMCollisionManagerComponent::GetDamageMeshAsset() const
+{
+    if (const USkinnedMeshComponent* skinnedMesh = Cast<USkinnedMeshComponent>(damageMesh)) {
+        return skinnedMesh->GetSkinnedAsset();
+    }
+    if (const UStaticMeshComponent* staticMesh = Cast<UStaticMeshComponent>(damageMesh)) {
+        return staticMesh->GetStaticMesh();
+    }
+    return nullptr;
+}
+
+void UACMCollisionManagerComponent::CompileTraceSockets(const FTraceInfo& trace, FACMCompiledTrace& outCompiled) const
+{
+    outCompiled.Mesh = damageMesh;
+    outCompiled.MeshAsset = GetDamageMeshAsset();
+    outCompiled.bValidSockets = CompileSocket(trace.StartSocket, outCompiled.StartSocket) && CompileSocket(trace.EndSocket, outCompiled.EndSocket);
+
+    if (!outCompiled.bValidSockets) {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid Socket Names!! - UACMCollisionManagerComponent::UpdateCollisions()"));
+    }
+}
+
+bool UACMCollisionManagerComponent::CompileSocket(const FName& socketName, FACMCompiledSocket& outSocket) const
+{
+    outSocket = FACMCompiledSocket();
+    outSocket.Name = socketName;
+
+    if (!damageMesh || !damageMesh->DoesSocketExist(socketName)) {
+        return false;
+    }
+
+    if (const USkinnedMeshComponent* skinnedMesh = Cast<USkinnedMeshComponent>(damageMesh)) {
+        // Followers of a leader pose don't own their bone transforms, keep querying them by name
+        if (skinnedMesh->LeaderPoseComponent.IsValid()) {
+            return true;
+        }
+
+        FTransform socketTransform;
+        int32 boneIndex = INDEX_NONE;
+        if (skinnedMesh->GetSocketInfoByName(socketName, socketTransform, boneIndex) && boneIndex != INDEX_NONE) {
+            outSocket.LocalTransform = socketTransform;
+        } else {
+            boneIndex = skinnedMesh->GetBoneIndex(socketName);
+        }
+
+        if (boneIndex != INDEX_NONE) {
+            outSocket.Space = EACMSocketSpace::EBoneSpace;
+            outSocket.BoneIndex = boneIndex;
+        }
+    } else if (const UStaticMeshComponent* staticMesh = Cast<UStaticMeshComponent>(damageMesh)) {
+        const UStaticMeshSocket* socket = staticMesh->GetSocketByName(socketName);
+        if (socket) {
+            outSocket.Space = EACMSocketSpace::EComponentSpace;
+            outSocket.LocalTransform = FTransform(socket->RelativeRotation, socket->RelativeLocation, socket->RelativeScale);
+        }
+    }
+    return true;
+}
+
+void UACMCollisionManagerComponent::CompileTraceQuery(const FName& traceName, FACMCompiledTrace& outCompiled) const
+{
+    FCollisionQueryParams& Params = outCompiled.Params;
+    Params = FCollisionQueryParams();
+
+    if (IgnoredActors.Num() > 0) {
+        Params.AddIgnoredActors(IgnoredActors);
+    }
+
+    if (bIgnoreOwner) {
+        Params.AddIgnoredActor(GetActorOwner());
+        Params.AddIgnoredActor(GetOwner());
+    }
+
+    Params.bReturnPhysicalMaterial = true;
+    Params.bTraceComplex = true;
+
+    if (!bAllowMultipleHitsPerSwing) {
+        const FHitActors* hitResact = alreadyHitActors.Find(traceName);
+        if (hitResact) {
+            for (const TObjectPtr<AActor>& hitActor : hitResact->AlreadyHitActors) {
+                Params.AddIgnoredActor(hitActor);
+            }
+        }
+    }
+
+    FCollisionObjectQueryParams& ObjectParams = outCompiled.ObjectParams;
+    ObjectParams = FCollisionObjectQueryParams();
+    for (const TEnumAsByte<ECollisionChannel>& channel : CollisionChannels) {
+        if (ObjectParams.IsValidObjectQuery(channel)) {
+            ObjectParams.AddObjectTypesToQuery(channel);
+        }
+    }
+
+    outCompiled.bValidQuery = ObjectParams.IsValid();
+    outCompiled.IgnoreSetVersion = ignoreSetVersion;
+}
+
+FVector UACMCollisionManagerComponent::GetCompiledSocketLocation(const FACMCompiledSocket& socket, const TArray<FTransform>* spaceTransforms, const FTransform& componentToWorld) const
+{
+    switch (socket.Space) {
+    case EACMSocketSpace::EBoneSpace:
+        if (spaceTransforms && spaceTransforms->IsValidIndex(socket.BoneIndex)) {
+            const FVector boneSpaceLocation = (*spaceTransforms)[socket.BoneIndex].TransformPosition(socket.LocalTransform.GetLocation());
+            return componentToWorld.TransformPosition(boneSpaceLocation);
+        }
+        break;
+    case EACMSocketSpace::EComponentSpace:
+        return componentToWorld.TransformPosition(socket.LocalTransform.GetLocation());
+    default:
+        break;
+    }
+    return damageMesh->GetSocketLocation(socket.Name);
+}
+
+void UACMCollisionManagerComponent::InvalidateCompiledQueries()
+{
+    ignoreSetVersion++;
+}
+
+void UACMCollisionManagerComponent::ResolveSweepRequest(const FACMSweepRequest& request, const FACMSweepResult& result)
+{
+    if (!result.bHit) {
+        return;
+    }
+
+    // The trace could have been stopped by a hit resolved earlier in the same batch
+    const FTraceInfo* activeTrace = activatedTraces.Find(request.TraceName);
+    if (!activeTrace || pendingDelete.Contains(request.TraceName)) {
+        return;
+    }
+
+    // Copied, handlers of the broadcast may start or stop traces and reallocate the map
+    const FTraceInfo currentTrace = *activeTrace;
+    const FHitResult& hitRes = result.HitResult;
+    OnCollisionDetected.Broadcast(hitRes);
+    if (!bAllowMultipleHitsPerSwing) {
+        alreadyHitActors.FindOrAdd(request.TraceName).Add(hitRes.GetActor());
+
+        FACMCompiledTrace* compiled = compiledTraces.Find(request.TraceName);
+        if (compiled) {
+            compiled->Params.AddIgnoredActor(hitRes.GetActor());
+        }
+    }
+    ApplyDamage(hitRes, currentTrace);
+}
+
 FTraceInfo UACMCollisionManagerComponent::GetFirstTrace() const
 {
     for (const auto& trace : DamageTraces) {
@@ -195,6 +350,8 @@ void UACMCollisionManagerComponent::SetupCollisionManager(class UMeshComponent*
         ParticleSystemComponents.Add(trace.Key, ParticleSystemComp);
         ParticleSystemComp->RegisterComponent();
     }
+
+    PrewarmTrailPools();
 }
 
 void UACMCollisionManagerComponent::StartAreaDamage_Implementation(const FVector& damageCenter, float damageRadius, float damageInterval /*= 1.f*/)
@@ -234,7 +391,7 @@ void UACMCollisionManagerComponent::PerformAreaDamage_Single_Local(const FVector
     }
 
     UWorld* world = GetWorld();
-    alreadyHitActorsBySphere.Empty();
+    alreadyHitActorsBySphere.Reset();
     outHits.Empty();
     if (world) {
         for (const TEnumAsByte<ECollisionChannel>& channel : CollisionChannels) {
@@ -246,8 +403,7 @@ void UACMCollisionManagerComponent::PerformAreaDamage_Single_Local(const FVector
             }
         }
         for (const auto& hit : outHits) {
-            if (!alreadyHitActorsBySphere.Contains(hit.GetActor())) {
-                alreadyHitActorsBySphere.Add(hit.GetActor());
+            if (alreadyHitActorsBySphere.Add(hit.GetActor())) {
                 ApplyDamage(hit, AreaDamageTraceInfo);
             }
         }
@@ -272,11 +428,13 @@ void UACMCollisionManagerComponent::PerformAreaDamageForDuration_Implementation(
 void UACMCollisionManagerComponent::AddActorToIgnore(class AActor* ignoredActor)
 {
     IgnoredActors.AddUnique(ignoredActor);
+    InvalidateCompiledQueries();
 }
 
 void UACMCollisionManagerComponent::AddCollisionChannel(TEnumAsByte<ECollisionChannel> inTraceChannel)
 {
     CollisionChannels.AddUnique(inTraceChannel);
+    InvalidateCompiledQueries();
 }
 
 void UACMCollisionManagerComponent::AddCollisionChannels(TArray<TEnumAsByte<ECollisionChannel>> inTraceChannels)
@@ -291,6 +449,7 @@ void UACMCollisionManagerComponent::AddCollisionChannels(TArray<TEnumAsByte<ECol
 void UACMCollisionManagerComponent::ClearCollisionChannels()
 {
     CollisionChannels.Empty();
+    InvalidateCompiledQueries();
 }
 
 void UACMCollisionManagerComponent::PerformSwipeTraceShot_Implementation(const FVector& start, const FVector& end, float radius = 0.f)
@@ -330,7 +489,7 @@ void UACMCollisionManagerComponent::PerformSwipeTraceShot_Local(const FVector& s
         Params.bReturnPhysicalMaterial = true;
         Params.bTraceComplex = true;
         /*        FCollisionObjectQueryParams ObjectParams;*/
-        alreadyHitActorsBySweep.Empty();
+        alreadyHitActorsBySweep.Reset();
         UWorld* world = GetWorld();
         if (world) {
             FHitResult outResult;
@@ -352,8 +511,7 @@ void UACMCollisionManagerComponent::PerformSwipeTraceShot_Local(const FVector& s
             bool bHit = world->SweepSingleByObjectType(
                 outResult, start, end, orientation.Quaternion(), ObjectParams, FCollisionShape::MakeSphere(radius), Params);
 
-            if (bHit && !alreadyHitActorsBySweep.Contains(outResult.GetActor())) {
-                alreadyHitActorsBySweep.Add(outResult.GetActor());
+            if (bHit && alreadyHitActorsBySweep.Add(outResult.GetActor())) {
                 ApplyDamage(outResult, SwipeTraceInfo);
                 outHit = outResult;
                 OnCollisionDetected.Broadcast(outResult);
@@ -376,6 +534,7 @@ void UACMCollisionManagerComponent::PerformSwipeTraceShot_Local(const FVector& s
 void UACMCollisionManagerComponent::StartAllTraces_Implementation()
 {
     activatedTraces.Empty();
+    compiledTraces.Empty();
     pendingDelete.Empty();
 
     for (const auto& damage : DamageTraces) {
@@ -400,6 +559,10 @@ void UACMCollisionManagerComponent::StartSingleTrace_Implementation(const FName&
         }
         outTrace->bIsFirstFrame = true;
         activatedTraces.Add(Name, *outTrace);
+
+        FACMCompiledTrace& compiled = compiledTraces.Add(Name);
+        CompileTraceSockets(*outTrace, compiled);
+        CompileTraceQuery(Name, compiled);
         PlayTrails(Name);
         SetStarted(true);
     } else {
@@ -415,19 +578,19 @@ void UACMCollisionManagerComponent::StopSingleTrace_Implementation(const FName&
 
         FHitActors* alreadyHit = alreadyHitActors.Find(Name);
         if (alreadyHit) {
-            alreadyHit->AlreadyHitActors.Empty();
+            alreadyHit->Reset();
         }
     }
 }
 
 void UACMCollisionManagerComponent::DisplayDebugTraces()
 {
-    TMap<FName, FTraceInfo> _sphere;
+    const TMap<FName, FTraceInfo>* _sphere = nullptr;
 
     FLinearColor DebugColor;
     switch (ShowDebugInfo) {
     case EDebugType::EAlwaysShowDebug:
-        _sphere = DamageTraces;
+        _sphere = &DamageTraces;
         if (bIsStarted)
             DebugColor = DebugActiveColor;
         else
@@ -435,7 +598,7 @@ void UACMCollisionManagerComponent::DisplayDebugTraces()
         break;
     case EDebugType::EShowInfoDuringSwing:
         if (bIsStarted) {
-            _sphere = activatedTraces;
+            _sphere = &activatedTraces;
 
             DebugColor = DebugActiveColor;
         } else
@@ -447,7 +610,7 @@ void UACMCollisionManagerComponent::DisplayDebugTraces()
         return;
     }
 
-    for (const TPair<FName, FTraceInfo>& box : _sphere) {
+    for (const TPair<FName, FTraceInfo>& box : *_sphere) {
         if (damageMesh->DoesSocketExist(box.Value.StartSocket) && damageMesh->DoesSocketExist(box.Value.EndSocket)) {
 
             const FVector StartPos = damageMesh->GetSocketLocation(box.Value.StartSocket);
@@ -540,6 +703,7 @@ bool UACMCollisionManagerComponent::IsTraceActive(const FName& traceName)
 void UACMCollisionManagerComponent::SetActorOwner(AActor* newOwner)
 {
     actorOwner = newOwner;
+    InvalidateCompiledQueries();
 }
 
 void UACMCollisionManagerComponent::ApplyDamage(const FHitResult& HitResult, const FBaseTraceInfo& currentTrace)
@@ -625,9 +789,17 @@ void UACMCollisionManagerComponent::PlayTrails_Implementation(const FName& trail
     }
 
     if (traceInfo.NiagaraTrail) {
-        UNiagaraComponent* niagaraComp = UNiagaraFunctionLibrary::SpawnSystemAttached(traceInfo.NiagaraTrail,
-            damageMesh, traceInfo.StartSocket, FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::SnapToTarget, false, true);
-        NiagaraSystemComponents.Add(trail, niagaraComp);
+        UNiagaraComponent* previousComp = NiagaraSystemComponents.FindRef(trail);
+        if (previousComp) {
+            ReleaseTrailComponent(previousComp);
+        }
+
+        UNiagaraComponent* niagaraComp = AcquireTrailComponent(traceInfo.NiagaraTrail);
+        if (niagaraComp) {
+            niagaraComp->AttachToComponent(damageMesh, FAttachmentTransformRules::SnapToTargetNotIncludingScale, traceInfo.StartSocket);
+            niagaraComp->Activate(true);
+            NiagaraSystemComponents.Add(trail, niagaraComp);
+        }
     }
 }
 
@@ -643,10 +815,78 @@ void UACMCollisionManagerComponent::StopTrails_Implementation(const FName& trail
         UNiagaraComponent* partComp = *NiagaraSystemComponents.Find(trail);
 
         if (partComp) {
-            partComp->DestroyComponent();
-            partComp->DeactivateImmediate();
-            partComp->DestroyInstance();
+            ReleaseTrailComponent(partComp);
         }
         NiagaraSystemComponents.Remove(trail);
     }
 }
+
+void UACMCollisionManagerComponent::PrewarmTrailPools()
+{
+    if (!FApp::CanEverRender()) {
+        return;
+    }
+
+    for (const auto& trace : DamageTraces) {
+        UNiagaraSystem* trailSystem = trace.Value.NiagaraTrail;
+        if (!trailSystem) {
+            continue;
+        }
+
+        FACMTrailPool& pool = TrailPools.FindOrAdd(trailSystem);
+        while (pool.FreeComponents.Num() < TrailPoolPrewarmCount) {
+            UNiagaraComponent* niagaraComp = CreateTrailComponent(trailSystem);
+            if (!niagaraComp) {
+                break;
+            }
+            pool.FreeComponents.Add(niagaraComp);
+        }
+    }
+}
+
+UNiagaraComponent* UACMCollisionManagerComponent::CreateTrailComponent(UNiagaraSystem* trailSystem)
+{
+    if (!damageMesh || !FApp::CanEverRender()) {
+        return nullptr;
+    }
+
+    UNiagaraComponent* niagaraComp = NewObject<UNiagaraComponent>(this, UNiagaraComponent::StaticClass());
+    niagaraComp->SetAsset(trailSystem);
+    niagaraComp->SetAutoActivate(false);
+    niagaraComp->SetAutoDestroy(false);
+    niagaraComp->SetupAttachment(damageMesh);
+    niagaraComp->RegisterComponent();
+    INC_DWORD_STAT(STAT_ACMTrailPoolComponents);
+    return niagaraComp;
+}
+
+UNiagaraComponent* UACMCollisionManagerComponent::AcquireTrailComponent(UNiagaraSystem* trailSystem)
+{
+    FACMTrailPool& pool = TrailPools.FindOrAdd(trailSystem);
+    while (pool.FreeComponents.Num() > 0) {
+        UNiagaraComponent* niagaraComp = pool.FreeComponents.Pop();
+        if (IsValid(niagaraComp)) {
+            INC_DWORD_STAT(STAT_ACMTrailPoolHits);
+            return niagaraComp;
+        }
+    }
+
+    INC_DWORD_STAT(STAT_ACMTrailPoolMisses);
+    return CreateTrailComponent(trailSystem);
+}
+
+void UACMCollisionManagerComponent::ReleaseTrailComponent(UNiagaraComponent* trailComp)
+{
+    if (!IsValid(trailComp)) {
+        return;
+    }
+
+    trailComp->DeactivateImmediate();
+    FACMTrailPool* pool = TrailPools.Find(trailComp->GetAsset());
+    if (pool) {
+        pool->FreeComponents.AddUnique(trailComp);
+    } else {
+        trailComp->DestroyComponent();
+        DEC_DWORD_STAT(STAT_ACMTrailPoolComponents);
+    }
+}
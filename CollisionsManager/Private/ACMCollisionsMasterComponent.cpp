@@ -3,6 +3,16 @@
 
 #include "ACMCollisionsMasterComponent.h"
 #include "ACMCollisionManagerComponent.h"
+#include "ACMStats.h"
+#include "Async/ParallelFor.h"
+#include <Engine/World.h>
+
+DECLARE_CYCLE_STAT(TEXT("Collisions Master Tick"), STAT_ACMMasterTick, STATGROUP_ACMCollisions);
+DECLARE_CYCLE_STAT(TEXT("Gather Sweeps"), STAT_ACMGatherSweeps, STATGROUP_ACMCollisions);
+DECLARE_CYCLE_STAT(TEXT("Dispatch Sweeps"), STAT_ACMDispatchSweeps, STATGROUP_ACMCollisions);
+DECLARE_CYCLE_STAT(TEXT("Resolve Sweeps"), STAT_ACMResolveSweeps, STATGROUP_ACMCollisions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sweeps Per Frame"), STAT_ACMSweepsPerFrame, STATGROUP_ACMCollisions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Managers"), STAT_ACMActiveManagers, STATGROUP_ACMCollisions);
 
 // Sets default values for this component's properties
 UACMCollisionsMasterComponent::UACMCollisionsMasterComponent()
@@ -29,20 +39,83 @@ void UACMCollisionsMasterComponent::BeginPlay()
 void UACMCollisionsMasterComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	SCOPE_CYCLE_COUNTER(STAT_ACMMasterTick);
+
 	for (UACMCollisionManagerComponent* del : pendingDelete) {
 		currentlyActiveComponents.Remove(del);
 	}
 
 	pendingDelete.Empty();
 
+	GatherSweeps();
+	DispatchSweeps(GetWorld());
+	ResolveSweeps();
+}
+
+void UACMCollisionsMasterComponent::GatherSweeps()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ACMGatherSweeps);
+	SET_DWORD_STAT(STAT_ACMActiveManagers, currentlyActiveComponents.Num());
+
+	sweepRequests.Reset();
 	for (UACMCollisionManagerComponent* comp : currentlyActiveComponents) {
-		if (IsValid(comp) &&  IsValid(comp->GetOwner())  ) {
-			comp->UpdateCollisions();
+		if (IsValid(comp) && IsValid(comp->GetOwner())) {
+			comp->GatherSweepRequests(sweepRequests);
 		}
 		else {
 			pendingDelete.Add(comp);
 		}
 	}
+	SET_DWORD_STAT(STAT_ACMSweepsPerFrame, sweepRequests.Num());
+}
+
+void UACMCollisionsMasterComponent::DispatchSweeps(const UWorld* world)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ACMDispatchSweeps);
+
+	const int32 numSweeps = sweepRequests.Num();
+	sweepResults.SetNum(numSweeps);
+	if (!world || numSweeps == 0) {
+		return;
+	}
+
+	// Each job only writes its own result slot, so the batch needs no locking
+	const bool bForceSingleThread = !bParallelSweeps || numSweeps < MinSweepsForParallelDispatch;
+	ParallelFor(numSweeps, [this, world](int32 index) {
+		FACMSweepResult& result = sweepResults[index];
+		result.bHit = PerformSweep(world, sweepRequests[index], result.HitResult);
+	}, bForceSingleThread);
+}
+
+void UACMCollisionsMasterComponent::ResolveSweeps()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ACMResolveSweeps);
+
+	// Results are merged in gather order so damage is applied deterministically
+	// regardless of how the sweeps were scheduled
+	for (int32 index = 0; index < sweepRequests.Num(); index++) {
+		const FACMSweepRequest& request = sweepRequests[index];
+		if (IsValid(request.Instigator) && IsValid(request.Instigator->GetOwner())) {
+			request.Instigator->ResolveSweepRequest(request, sweepResults[index]);
+		}
+	}
+	sweepRequests.Reset();
+	sweepResults.Reset();
+}
+
+bool UACMCollisionsMasterComponent::PerformSweep(const UWorld* world, const FACMSweepRequest& request, FHitResult& outHit)
+{
+	outHit = FHitResult();
+	const FCollisionShape shape = FCollisionShape::MakeSphere(request.Radius);
+
+	bool bHit = world->SweepSingleByObjectType(
+		outHit, request.StartPos, request.EndPos, request.Orientation, *request.ObjectParams, shape, *request.Params);
+
+	if (!bHit && request.bCrossframe) {
+		bHit = world->SweepSingleByObjectType(
+			outHit, request.StartPos, request.OldEndPos, request.Orientation, *request.ObjectParams, shape, *request.Params);
+	}
+	return bHit;
 }
 
 void UACMCollisionsMasterComponent::AddComponent(class UACMCollisionManagerComponent* compToAdd)
@@ -59,4 +132,3 @@ void UACMCollisionsMasterComponent::RemoveComponent(class UACMCollisionManagerCo
 		pendingDelete.Add(compToAdd);
 	}
 }
-
@@ -2,6 +2,7 @@
 
 #include "ACMEffectsDispatcherComponent.h"
 #include "ACMImpactsFXDataAsset.h"
+#include "ACMStats.h"
 #include "ACMTypes.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
@@ -13,22 +14,40 @@
 #include "NiagaraCommon.h"
 #include "NiagaraSystem.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Replicated Impacts"), STAT_ACMReplicatedImpacts, STATGROUP_ACMCollisions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Impacts"), STAT_ACMCulledImpacts, STATGROUP_ACMCollisions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawned FXs"), STAT_ACMSpawnedFXs, STATGROUP_ACMCollisions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled FXs"), STAT_ACMCulledFXs, STATGROUP_ACMCollisions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Sounds"), STAT_ACMSkippedSounds, STATGROUP_ACMCollisions);
 
 // Sets default values for this component's properties
 UACMEffectsDispatcherComponent::UACMEffectsDispatcherComponent()
 {
     // Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
     // off to improve performance if you don't need them.
-    PrimaryComponentTick.bCanEverTick = false;
-    // ...
+    // Only ticks during the frames it has impacts to send or FXs to spawn
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
 }
 
 // Called when the game starts
 void UACMEffectsDispatcherComponent::BeginPlay()
 {
     Super::BeginPlay();
-    // ...
+    RegisterImpactFXs();
+}
+
+void UACMEffectsDispatcherComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    FlushReplicatedImpacts();
+    FlushFXSpawns();
+    SetComponentTickEnabled(false);
 }
 
 void UACMEffectsDispatcherComponent::ClientsPlayEffect_Implementation(const FActionEffect& effect, class ACharacter* instigator)
@@ -56,6 +75,13 @@ void UACMEffectsDispatcherComponent::PlayActionEffectLocally(const FActionEffect
 
 void UACMEffectsDispatcherComponent::PlayReplicatedImpact(const TSubclassOf<class UDamageType>& damageImpacting, class UPhysicalMaterial* materialImpacted, const FVector& impactLocation)
 {
+    int32 fxIndex;
+    if (bBatchReplicatedImpacts && ImpactFXs && GetOwner() && GetOwner()->HasAuthority()
+        && ImpactFXs->TryGetImpactFXIndex(damageImpacting, materialImpacted, fxIndex)) {
+        QueueReplicatedImpact(static_cast<uint16>(fxIndex), impactLocation);
+        return;
+    }
+
     FBaseFX outFX;
     if (TryGetImpactFX(damageImpacting, materialImpacted, outFX)) {
         FImpactFX newImpact = FImpactFX(outFX, impactLocation);
@@ -116,24 +142,153 @@ FAttachedComponents UACMEffectsDispatcherComponent::SpawnSoundAndParticleAttache
     if (effect.NiagaraParticle) {
         comps.NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAttached(effect.NiagaraParticle, instigator->GetMesh(), effect.SocketOrBoneName,
             effect.RelativeOffset.GetLocation(), effect.RelativeOffset.GetRotation().Rotator(), effect.RelativeOffset.GetScale3D(),
-            EAttachLocation::SnapToTarget, true, ENCPoolMethod::AutoRelease);
+            EAttachLocation::SnapToTarget, true, GetPoolMethod(effect.NiagaraParticle));
     }
     return comps;
 }
 
 void UACMEffectsDispatcherComponent::SpawnSoundAndParticleAtLocation(const FImpactFX& effect)
+{
+    if (!FApp::CanEverRender()) {
+        return;
+    }
+
+    const float distanceSq = GetDistanceSqToClosestViewer(effect.SpawnLocation.GetLocation());
+    if (MaxFXSpawnDistance > 0.f && distanceSq > FMath::Square(MaxFXSpawnDistance)) {
+        INC_DWORD_STAT(STAT_ACMCulledFXs);
+        return;
+    }
+
+    pendingFXSpawns.Emplace(effect, distanceSq);
+    SetComponentTickEnabled(true);
+}
+
+void UACMEffectsDispatcherComponent::FlushFXSpawns()
+{
+    if (pendingFXSpawns.Num() == 0) {
+        return;
+    }
+
+    if (MaxFXSpawnsPerFrame > 0 && pendingFXSpawns.Num() > MaxFXSpawnsPerFrame) {
+        pendingFXSpawns.StableSort([](const FACMPendingFXSpawn& first, const FACMPendingFXSpawn& second) {
+            return first.DistanceSq < second.DistanceSq;
+        });
+        INC_DWORD_STAT_BY(STAT_ACMCulledFXs, pendingFXSpawns.Num() - MaxFXSpawnsPerFrame);
+        pendingFXSpawns.SetNum(MaxFXSpawnsPerFrame);
+    }
+
+    soundInstancesThisFrame.Reset();
+    for (const FACMPendingFXSpawn& pendingSpawn : pendingFXSpawns) {
+        SpawnFXAtLocation(pendingSpawn.Effect);
+    }
+    INC_DWORD_STAT_BY(STAT_ACMSpawnedFXs, pendingFXSpawns.Num());
+    pendingFXSpawns.Reset();
+}
+
+void UACMEffectsDispatcherComponent::SpawnFXAtLocation(const FImpactFX& effect)
 {
     if (effect.ActionParticle) {
         UGameplayStatics::SpawnEmitterAtLocation(this, effect.ActionParticle, effect.SpawnLocation.GetLocation(),
-            effect.SpawnLocation.GetRotation().Rotator(), effect.SpawnLocation.GetScale3D());
+            effect.SpawnLocation.GetRotation().Rotator(), effect.SpawnLocation.GetScale3D(), true, EPSCPoolMethod::AutoRelease);
     }
 
-    if (effect.ActionSound) {
-        UGameplayStatics::SpawnSoundAtLocation(this, effect.ActionSound, effect.SpawnLocation.GetLocation());
+    // Fire and forget, no audio component is created for sounds that won't be heard
+    if (effect.ActionSound && CanPlaySound(effect.ActionSound)) {
+        UGameplayStatics::PlaySoundAtLocation(this, effect.ActionSound, effect.SpawnLocation.GetLocation());
     }
 
     if (effect.NiagaraParticle) {
         UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, effect.NiagaraParticle, effect.SpawnLocation.GetLocation(),
-            effect.SpawnLocation.GetRotation().Rotator(), effect.SpawnLocation.GetScale3D());
+            effect.SpawnLocation.GetRotation().Rotator(), effect.SpawnLocation.GetScale3D(), true, true, GetPoolMethod(effect.NiagaraParticle));
+    }
+}
+
+bool UACMEffectsDispatcherComponent::CanPlaySound(USoundBase* sound)
+{
+    if (MaxSoundInstancesPerFrame <= 0) {
+        return true;
+    }
+
+    int32& instances = soundInstancesThisFrame.FindOrAdd(sound);
+    if (instances >= MaxSoundInstancesPerFrame) {
+        INC_DWORD_STAT(STAT_ACMSkippedSounds);
+        return false;
+    }
+    instances++;
+    return true;
+}
+
+ENCPoolMethod UACMEffectsDispatcherComponent::GetPoolMethod(UNiagaraSystem* niagaraSystem) const
+{
+    const ENCPoolMethod* poolMethod = PoolMethodOverrides.Find(niagaraSystem);
+    return poolMethod ? *poolMethod : DefaultPoolMethod;
+}
+
+float UACMEffectsDispatcherComponent::GetDistanceSqToClosestViewer(const FVector& location) const
+{
+    float closestDistanceSq = TNumericLimits<float>::Max();
+    const UWorld* world = GetWorld();
+    if (!world) {
+        return closestDistanceSq;
+    }
+
+    // On the server this checks every connected player, on clients only the local ones
+    for (FConstPlayerControllerIterator iterator = world->GetPlayerControllerIterator(); iterator; ++iterator) {
+        const APlayerController* playerController = iterator->Get();
+        const AActor* viewTarget = playerController ? playerController->GetViewTarget() : nullptr;
+        if (viewTarget) {
+            closestDistanceSq = FMath::Min(closestDistanceSq, FVector::DistSquared(viewTarget->GetActorLocation(), location));
+        }
+    }
+    return closestDistanceSq;
+}
+
+void UACMEffectsDispatcherComponent::RegisterImpactFXs()
+{
+    RegisteredImpactFXs.Reset();
+    if (ImpactFXs) {
+        ImpactFXs->GetAllImpactFXs(RegisteredImpactFXs);
+    }
+}
+
+void UACMEffectsDispatcherComponent::QueueReplicatedImpact(uint16 fxIndex, const FVector& impactLocation)
+{
+    if (!IsImpactInCullDistance(impactLocation)) {
+        INC_DWORD_STAT(STAT_ACMCulledImpacts);
+        return;
+    }
+
+    if (pendingImpacts.Num() >= MaxImpactsPerBatch) {
+        INC_DWORD_STAT(STAT_ACMCulledImpacts);
+        return;
+    }
+
+    pendingImpacts.Add(FACMReplicatedImpact(impactLocation, fxIndex));
+    SetComponentTickEnabled(true);
+}
+
+void UACMEffectsDispatcherComponent::FlushReplicatedImpacts()
+{
+    if (pendingImpacts.Num() > 0) {
+        INC_DWORD_STAT_BY(STAT_ACMReplicatedImpacts, pendingImpacts.Num());
+        ClientsPlayImpactsBatch(pendingImpacts);
+        pendingImpacts.Reset();
+    }
+}
+
+void UACMEffectsDispatcherComponent::ClientsPlayImpactsBatch_Implementation(const TArray<FACMReplicatedImpact>& impacts)
+{
+    for (const FACMReplicatedImpact& impact : impacts) {
+        if (RegisteredImpactFXs.IsValidIndex(impact.FXIndex) && IsImpactInCullDistance(impact.Location)) {
+            SpawnSoundAndParticleAtLocation(FImpactFX(RegisteredImpactFXs[impact.FXIndex], impact.Location));
+        }
+    }
+}
+
+bool UACMEffectsDispatcherComponent::IsImpactInCullDistance(const FVector& impactLocation) const
+{
+    if (ImpactCullDistance <= 0.f) {
+        return true;
     }
+    return GetDistanceSqToClosestViewer(impactLocation) <= FMath::Square(ImpactCullDistance);
 }
@@ -2,27 +2,126 @@
 
 #include "ACMImpactsFXDataAsset.h"
 #include "ACMTypes.h"
+#include "UObject/UObjectHash.h"
+
+void UACMImpactsFXDataAsset::PostLoad()
+{
+    Super::PostLoad();
+    CompileImpactFXs();
+}
+
+#if WITH_EDITOR
+void UACMImpactsFXDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    CompileImpactFXs();
+}
+#endif
 
 bool UACMImpactsFXDataAsset::TryGetImpactFX(const TSubclassOf<class UDamageType>& damageImpacting, class UPhysicalMaterial* materialImpacted, FBaseFX& outFXtoPlay)
 {
-    if (ImpactFXsByDamageType.Contains(damageImpacting)) {
-        const FImpactsArray& impacts = ImpactFXsByDamageType.FindChecked(damageImpacting);
-
-        if (impacts.ImpactsFX.Contains(materialImpacted)) {
-            const FMaterialImpactFX* matfx = impacts.ImpactsFX.FindByKey(materialImpacted);
-            outFXtoPlay = FBaseFX(matfx->ActionSound, matfx->NiagaraParticle, matfx->ActionParticle);
-            return true;
-        } 
-    } else {
-    //IF WE DON'T FIND THAT DAMAGE TYPE, WE TRY HIS CHILD CLASSES
-        for (auto& impfx : ImpactFXsByDamageType) {
-        if (damageImpacting->IsChildOf(impfx.Key)) {
-                const FImpactsArray& impacts = ImpactFXsByDamageType.FindChecked(impfx.Key);
-                const FMaterialImpactFX* matfx = impacts.ImpactsFX.FindByKey(materialImpacted);
-                outFXtoPlay = FBaseFX(matfx->ActionSound, matfx->NiagaraParticle, matfx->ActionParticle);
-                return true;
+    int32 fxIndex;
+    if (TryGetImpactFXIndex(damageImpacting, materialImpacted, fxIndex)) {
+        outFXtoPlay = compiledFXs[fxIndex];
+        return true;
+    }
+    return false;
+}
+
+bool UACMImpactsFXDataAsset::TryGetImpactFXIndex(const TSubclassOf<class UDamageType>& damageImpacting, const class UPhysicalMaterial* materialImpacted, int32& outIndex)
+{
+    if (!bCompiled) {
+        CompileImpactFXs();
+    }
+
+    if (!damageImpacting) {
+        return false;
+    }
+
+    const int32 row = ResolveDamageTypeRow(damageImpacting);
+    if (row == INDEX_NONE) {
+        return false;
+    }
+
+    // Matched on the material itself, materials sharing a surface type can have different FXs
+    const int16* fxIndex = compiledRows[row].Find(materialImpacted);
+    if (!fxIndex) {
+        return false;
+    }
+    outIndex = *fxIndex;
+    return true;
+}
+
+void UACMImpactsFXDataAsset::GetAllImpactFXs(TArray<FBaseFX>& outFXs)
+{
+    if (!bCompiled) {
+        CompileImpactFXs();
+    }
+    outFXs = compiledFXs;
+}
+
+void UACMImpactsFXDataAsset::CompileImpactFXs()
+{
+    compiledFXs.Reset();
+    compiledRows.Reset();
+    damageTypeRows.Reset();
+
+    for (const auto& impfx : ImpactFXsByDamageType) {
+        if (!impfx.Key) {
+            continue;
+        }
+
+        const int32 row = compiledRows.AddDefaulted();
+        damageTypeRows.Add(impfx.Key, row);
+
+        for (const FMaterialImpactFX& matfx : impfx.Value.ImpactsFX) {
+            // Impacts without a physical material only match hits without one
+            if (compiledRows[row].Contains(matfx.ImpactMaterial)) {
+                UE_LOG(LogTemp, Warning, TEXT("%s lists %s more than once for %s, only the first one is played - UACMImpactsFXDataAsset"),
+                    *GetName(), *GetNameSafe(matfx.ImpactMaterial), *impfx.Key->GetName());
+                continue;
+            }
+
+            int32 compiledIndex = compiledFXs.IndexOfByPredicate([&matfx](const FBaseFX& fx) {
+                return fx.ActionSound == matfx.ActionSound && fx.NiagaraParticle == matfx.NiagaraParticle && fx.ActionParticle == matfx.ActionParticle;
+            });
+            if (compiledIndex == INDEX_NONE) {
+                compiledIndex = compiledFXs.Add(FBaseFX(matfx.ActionSound, matfx.NiagaraParticle, matfx.ActionParticle));
             }
+            check(compiledIndex <= MAX_int16);
+            compiledRows[row].Add(matfx.ImpactMaterial, static_cast<int16>(compiledIndex));
         }
     }
-    return false;
+
+    // Resolve the class hierarchy fallback upfront for every damage type loaded so far,
+    // the ones loaded later are resolved on their first impact
+    TArray<UClass*> damageClasses;
+    GetDerivedClasses(UDamageType::StaticClass(), damageClasses);
+    damageClasses.Add(UDamageType::StaticClass());
+    for (UClass* damageClass : damageClasses) {
+        ResolveDamageTypeRow(damageClass);
+    }
+
+    bCompiled = true;
+}
+
+int32 UACMImpactsFXDataAsset::ResolveDamageTypeRow(UClass* damageClass)
+{
+    const int32* cachedRow = damageTypeRows.Find(damageClass);
+    if (cachedRow) {
+        return *cachedRow;
+    }
+
+    // If we don't find that damage type, we use its closest configured parent
+    int32 row = INDEX_NONE;
+    for (UClass* parentClass = damageClass->GetSuperClass(); parentClass; parentClass = parentClass->GetSuperClass()) {
+        const int32* parentRow = damageTypeRows.Find(parentClass);
+        if (parentRow) {
+            row = *parentRow;
+            break;
+        }
+    }
+
+    damageTypeRows.Add(damageClass, row);
+    return row;
 }
@@ -58,6 +58,10 @@ protected:
     UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "ACM|Traces")
     TMap<FName, FTraceInfo> DamageTraces;
 
+    /*Number of Niagara trail components created upfront for every trail system used by the Damage Traces*/
+    UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, meta = (ClampMin = 0), Category = "ACM|Traces")
+    int32 TrailPoolPrewarmCount = 1;
+
     UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "ACM|Traces")
     FBaseTraceInfo SwipeTraceInfo;
 
@@ -166,8 +170,15 @@ public:
 
     FRotator GetLineRotation(FVector start, FVector end);
 
+    /*Gathers and sweeps all the active traces of this component serially*/
     void UpdateCollisions();
 
+    /*Adds one sweep per active trace to the frame batch built by the Collisions Master*/
+    void GatherSweepRequests(TArray<FACMSweepRequest>& outRequests);
+
+    /*Handles the outcome of a sweep gathered by this component*/
+    void ResolveSweepRequest(const FACMSweepRequest& request, const FACMSweepResult& result);
+
     FTraceInfo GetFirstTrace() const;
 
 private:
@@ -185,8 +196,25 @@ private:
     UPROPERTY()
     TMap<FName, FHitActors> alreadyHitActors;
 
-    TArray<TObjectPtr<AActor>> alreadyHitActorsBySphere;
-    TArray<TObjectPtr<AActor>> alreadyHitActorsBySweep;
+    TMap<FName, FACMCompiledTrace> compiledTraces;
+
+    // Bumped whenever the ignored actors, the owner or the collision channels change
+    uint32 ignoreSetVersion = 1;
+
+    const UObject* GetDamageMeshAsset() const;
+
+    void CompileTraceSockets(const FTraceInfo& trace, FACMCompiledTrace& outCompiled) const;
+
+    bool CompileSocket(const FName& socketName, FACMCompiledSocket& outSocket) const;
+
+    void CompileTraceQuery(const FName& traceName, FACMCompiledTrace& outCompiled) const;
+
+    FVector GetCompiledSocketLocation(const FACMCompiledSocket& socket, const TArray<FTransform>* spaceTransforms, const FTransform& componentToWorld) const;
+
+    void InvalidateCompiledQueries();
+
+    FHitActors alreadyHitActorsBySphere;
+    FHitActors alreadyHitActorsBySweep;
     bool bIsStarted = false;
 
     void DisplayDebugTraces();
@@ -205,6 +233,17 @@ private:
     UPROPERTY()
     TMap<FName, class UNiagaraComponent*> NiagaraSystemComponents;
 
+    UPROPERTY()
+    TMap<TObjectPtr<class UNiagaraSystem>, FACMTrailPool> TrailPools;
+
+    void PrewarmTrailPools();
+
+    class UNiagaraComponent* CreateTrailComponent(class UNiagaraSystem* trailSystem);
+
+    class UNiagaraComponent* AcquireTrailComponent(class UNiagaraSystem* trailSystem);
+
+    void ReleaseTrailComponent(class UNiagaraComponent* trailComp);
+
     void ApplyDamage(const FHitResult& HitResult, const FBaseTraceInfo& currentTrace);
 
     void ApplyPointDamage(const FHitResult& HitResult, const FBaseTraceInfo& currentTrace);
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "ACMTypes.h"
 #include "ACMCollisionsMasterComponent.generated.h"
 
 
@@ -20,6 +21,15 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	/*If true, the sweeps of all active traces are dispatched across worker threads.
+	Hits are always resolved on the game thread in a deterministic order*/
+	UPROPERTY(EditDefaultsOnly, Category = ACM)
+	bool bParallelSweeps = true;
+
+	/*Below this number of sweeps in a frame the batch is executed on the game thread*/
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bParallelSweeps", ClampMin = 1), Category = ACM)
+	int32 MinSweepsForParallelDispatch = 16;
+
 public:	
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -28,6 +38,9 @@ public:
 
 	void RemoveComponent(class UACMCollisionManagerComponent* compToAdd);
 
+	/*Performs a single gathered sweep. Safe to call from worker threads*/
+	static bool PerformSweep(const UWorld* world, const FACMSweepRequest& request, FHitResult& outHit);
+
 private:
 
 	UPROPERTY()
@@ -35,4 +48,14 @@ private:
 
 	UPROPERTY()
 	TArray<class UACMCollisionManagerComponent*> pendingDelete;
+
+	TArray<FACMSweepRequest> sweepRequests;
+
+	TArray<FACMSweepResult> sweepResults;
+
+	void GatherSweeps();
+
+	void DispatchSweeps(const UWorld* world);
+
+	void ResolveSweeps();
 };
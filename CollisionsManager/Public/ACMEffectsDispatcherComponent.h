@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "ACMTypes.h"
+#include "NiagaraCommon.h"
 #include "ACMEffectsDispatcherComponent.generated.h"
 
 
@@ -23,6 +24,43 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = ACM)
 	class UACMImpactsFXDataAsset* ImpactFXs;
+
+	/*If true, the impacts played on the server are gathered during the frame
+	and sent to clients in a single unreliable multicast*/
+	UPROPERTY(EditDefaultsOnly, Category = "ACM|Replication")
+	bool bBatchReplicatedImpacts = true;
+
+	/*Impacts further than this from every player view target are not sent nor played. 0 disables culling*/
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bBatchReplicatedImpacts", ClampMin = 0.f), Category = "ACM|Replication")
+	float ImpactCullDistance = 8000.f;
+
+	/*Maximum number of impacts sent in a single frame, the exceeding ones are dropped*/
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bBatchReplicatedImpacts", ClampMin = 1), Category = "ACM|Replication")
+	int32 MaxImpactsPerBatch = 64;
+
+	/*Pool method used for Niagara FXs without an override*/
+	UPROPERTY(EditDefaultsOnly, Category = "ACM|Spawning")
+	ENCPoolMethod DefaultPoolMethod = ENCPoolMethod::AutoRelease;
+
+	/*Per asset pool method, overrides the default one*/
+	UPROPERTY(EditDefaultsOnly, Category = "ACM|Spawning")
+	TMap<TObjectPtr<class UNiagaraSystem>, ENCPoolMethod> PoolMethodOverrides;
+
+	/*Maximum number of location based FXs spawned in a frame, the closest to the viewers win. 0 means no limit*/
+	UPROPERTY(EditDefaultsOnly, meta = (ClampMin = 0), Category = "ACM|Spawning")
+	int32 MaxFXSpawnsPerFrame = 32;
+
+	/*Location based FXs further than this from every local viewer are not spawned. 0 disables culling*/
+	UPROPERTY(EditDefaultsOnly, meta = (ClampMin = 0.f), Category = "ACM|Spawning")
+	float MaxFXSpawnDistance = 6000.f;
+
+	/*Maximum instances of the same sound started in a frame, checked before the sound is played. 0 means no limit*/
+	UPROPERTY(EditDefaultsOnly, meta = (ClampMin = 0), Category = "ACM|Spawning")
+	int32 MaxSoundInstancesPerFrame = 2;
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 private:
 
 	UFUNCTION(NetMulticast, Reliable, Category = ACM)
@@ -31,6 +69,36 @@ private:
 	UFUNCTION(NetMulticast, Reliable, Category = ACM)
 	void ClientsPlayReplicatedEffect(const FImpactFX& FXtoPlay);
 
+	UFUNCTION(NetMulticast, Unreliable, Category = ACM)
+	void ClientsPlayImpactsBatch(const TArray<FACMReplicatedImpact>& impacts);
+
+	// Same content and order on server and clients, impacts are replicated as indexes into it
+	TArray<FBaseFX> RegisteredImpactFXs;
+
+	TArray<FACMReplicatedImpact> pendingImpacts;
+
+	void RegisterImpactFXs();
+
+	void QueueReplicatedImpact(uint16 fxIndex, const FVector& impactLocation);
+
+	void FlushReplicatedImpacts();
+
+	bool IsImpactInCullDistance(const FVector& impactLocation) const;
+
+	TArray<FACMPendingFXSpawn> pendingFXSpawns;
+
+	TMap<TObjectPtr<class USoundBase>, int32> soundInstancesThisFrame;
+
+	void FlushFXSpawns();
+
+	void SpawnFXAtLocation(const FImpactFX& effect);
+
+	bool CanPlaySound(class USoundBase* sound);
+
+	ENCPoolMethod GetPoolMethod(class UNiagaraSystem* niagaraSystem) const;
+
+	float GetDistanceSqToClosestViewer(const FVector& location) const;
+
 
 
 public:	
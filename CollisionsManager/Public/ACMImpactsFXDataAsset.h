@@ -22,7 +22,37 @@ protected:
 
 public: 
 
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	UFUNCTION(BlueprintCallable, Category = ACM)
 	bool TryGetImpactFX(const TSubclassOf<class UDamageType>& damageImpacting, class UPhysicalMaterial* materialImpacted, FBaseFX& outFXtoPlay);
 
+	/*Index of the FX to play in the array returned by GetAllImpactFXs*/
+	bool TryGetImpactFXIndex(const TSubclassOf<class UDamageType>& damageImpacting, const class UPhysicalMaterial* materialImpacted, int32& outIndex);
+
+	/*Collects every distinct FX of this asset, in the same order on every machine*/
+	void GetAllImpactFXs(TArray<FBaseFX>& outFXs);
+
+private:
+
+	// Distinct FXs of the asset, referenced by index from the compiled rows
+	UPROPERTY(Transient)
+	TArray<FBaseFX> compiledFXs;
+
+	// Row of the closest configured damage type for every damage type queried so far, INDEX_NONE if there is none
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<class UDamageType>, int32> damageTypeRows;
+
+	// FX index of every configured physical material, one map per configured damage type
+	TArray<TMap<TObjectKey<UPhysicalMaterial>, int16>> compiledRows;
+
+	bool bCompiled = false;
+
+	void CompileImpactFXs();
+
+	int32 ResolveDamageTypeRow(UClass* damageClass);
 };
@@ -3,7 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
 #include "Engine/DataTable.h"
+#include "Engine/HitResult.h"
+#include "Engine/NetSerialization.h"
 #include "NiagaraSystem.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Sound/SoundCue.h"
@@ -50,7 +53,31 @@ struct FHitActors {
 
 public:
     UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = ACM)
-    TArray<class AActor*> AlreadyHitActors;
+    TSet<TObjectPtr<class AActor>> AlreadyHitActors;
+
+    FORCEINLINE bool Contains(const AActor* actor) const
+    {
+        return AlreadyHitActors.Contains(actor);
+    }
+
+    /*Returns true if the actor was not hit yet*/
+    FORCEINLINE bool Add(AActor* actor)
+    {
+        bool bAlreadyHit = false;
+        AlreadyHitActors.Add(actor, &bAlreadyHit);
+        return !bAlreadyHit;
+    }
+
+    /*Clears the hits keeping the allocated buckets for the next swing*/
+    FORCEINLINE void Reset()
+    {
+        AlreadyHitActors.Reset();
+    }
+
+    FORCEINLINE int32 Num() const
+    {
+        return AlreadyHitActors.Num();
+    }
 };
 
 UENUM(BlueprintType)
@@ -249,6 +276,59 @@ public:
     TArray<FMaterialImpactFX> ImpactsFX;
 };
 
+/*Impact sent to clients inside a batch. The FX is referenced by its index in the
+table every Effects Dispatcher builds from its Impacts FX data asset*/
+USTRUCT()
+struct FACMReplicatedImpact {
+    GENERATED_BODY()
+
+public:
+    FACMReplicatedImpact()
+    {
+        Location = FVector::ZeroVector;
+        FXIndex = 0;
+    }
+
+    FACMReplicatedImpact(const FVector& inLocation, uint16 inFXIndex)
+    {
+        Location = inLocation;
+        FXIndex = inFXIndex;
+    }
+
+    UPROPERTY()
+    FVector_NetQuantize Location;
+
+    UPROPERTY()
+    uint16 FXIndex;
+};
+
+/*Location based FX waiting for the end of frame spawn pass*/
+struct FACMPendingFXSpawn {
+
+    FACMPendingFXSpawn(const FImpactFX& inEffect, float inDistanceSq)
+        : Effect(inEffect)
+        , DistanceSq(inDistanceSq)
+    {
+    }
+
+    FImpactFX Effect;
+
+    // Squared distance to the closest local viewer, closer FX have higher priority
+    float DistanceSq;
+};
+
+USTRUCT()
+struct FACMTrailPool {
+    GENERATED_BODY()
+
+public:
+    FACMTrailPool() {};
+
+    // Trail components of a single Niagara system, ready to be reattached
+    UPROPERTY()
+    TArray<TObjectPtr<UNiagaraComponent>> FreeComponents;
+};
+
 USTRUCT(BlueprintType)
 struct FBaseTraceInfo {
 
@@ -318,6 +398,102 @@ public:
     FVector oldEndSocketPos;
 };
 
+enum class EACMSocketSpace : uint8 {
+    // Socket could not be resolved to a cached transform, queried by name every frame
+    ENamedSocket,
+    // Socket relative to a bone of a skinned mesh, read from the component space transforms
+    EBoneSpace,
+    // Socket relative to the mesh component itself
+    EComponentSpace,
+};
+
+struct FACMCompiledSocket {
+
+    FACMCompiledSocket()
+    {
+        Name = NAME_None;
+        Space = EACMSocketSpace::ENamedSocket;
+        BoneIndex = INDEX_NONE;
+        LocalTransform = FTransform::Identity;
+    }
+
+    FName Name;
+    EACMSocketSpace Space;
+    int32 BoneIndex;
+    FTransform LocalTransform;
+};
+
+/*Per trace state resolved once when the trace is activated and reused every frame
+until the damage mesh or the ignore set changes*/
+struct FACMCompiledTrace {
+
+    FACMCompiledTrace()
+    {
+        IgnoreSetVersion = 0;
+        bValidSockets = false;
+        bValidQuery = false;
+    }
+
+    FACMCompiledSocket StartSocket;
+    FACMCompiledSocket EndSocket;
+
+    // Mesh and mesh asset the sockets were resolved against
+    TWeakObjectPtr<class UMeshComponent> Mesh;
+    TWeakObjectPtr<const UObject> MeshAsset;
+
+    FCollisionQueryParams Params;
+    FCollisionObjectQueryParams ObjectParams;
+    uint32 IgnoreSetVersion;
+
+    bool bValidSockets;
+    bool bValidQuery;
+};
+
+/*A single sweep gathered from an active trace. Collected by the Collisions Master
+into one batch per frame, swept (possibly in parallel) and then resolved in order*/
+struct FACMSweepRequest {
+
+    FACMSweepRequest()
+    {
+        Instigator = nullptr;
+        TraceName = NAME_None;
+        StartPos = FVector::ZeroVector;
+        EndPos = FVector::ZeroVector;
+        OldEndPos = FVector::ZeroVector;
+        Orientation = FQuat::Identity;
+        Radius = 0.f;
+        bCrossframe = false;
+        Params = nullptr;
+        ObjectParams = nullptr;
+    }
+
+    class UACMCollisionManagerComponent* Instigator;
+    FName TraceName;
+    FVector StartPos;
+    FVector EndPos;
+    FVector OldEndPos;
+    FQuat Orientation;
+    float Radius;
+
+    // Sweep again towards last frame's end socket position if the first sweep misses
+    bool bCrossframe;
+
+    // Owned by the instigator's compiled trace, valid until the batch is resolved
+    const FCollisionQueryParams* Params;
+    const FCollisionObjectQueryParams* ObjectParams;
+};
+
+struct FACMSweepResult {
+
+    FACMSweepResult()
+    {
+        bHit = false;
+    }
+
+    FHitResult HitResult;
+    bool bHit;
+};
+
 UCLASS()
 class COLLISIONSMANAGER_API UACMTypes : public UObject {
     GENERATED_BODY()
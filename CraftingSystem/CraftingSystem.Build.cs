@@ -27,7 +27,7 @@ public class CraftingSystem : ModuleRules
 			{
 				"Core",
               "AscentCombatFramework",
-              "AdvancedRPGSystem","InventorySystem"
+              "AdvancedRPGSystem","InventorySystem", "AscentSaveSystem"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -43,6 +43,16 @@ void UACFBuildableComponent::OnComponentSaved_Implementation()
 {
 }
 
+void UACFBuildableComponent::NativeOnComponentLoaded()
+{
+    OnComponentLoaded_Implementation();
+}
+
+void UACFBuildableComponent::NativeOnComponentSaved()
+{
+    OnComponentSaved_Implementation();
+}
+
 void UACFBuildableComponent::SetBuildingState(const EBuildableState newState)
 {
     BuildingState = newState;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ALSSavableComponentInterface.h"
 #include "Components/ActorComponent.h"
 #include "CoreMinimal.h"
 #include "Items/ACFItem.h"
@@ -19,7 +20,7 @@ enum class EBuildableState : uint8 {
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBuildableStatusChanged, const EBuildableState, newState);
 
 UCLASS(ClassGroup = (ACF), meta = (BlueprintSpawnableComponent))
-class CRAFTINGSYSTEM_API UACFBuildableComponent : public UActorComponent {
+class CRAFTINGSYSTEM_API UACFBuildableComponent : public UActorComponent, public IALSSavableComponentInterface {
     GENERATED_BODY()
 
 public:
@@ -42,6 +43,11 @@ protected:
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = ACF)
     void OnComponentSaved();
 
+    /*IALSSavableComponentInterface*/
+    virtual void NativeOnComponentLoaded() override;
+
+    virtual void NativeOnComponentSaved() override;
+
 public:
     /* ----------------- GETTERS -----------------------*/
     UFUNCTION(BlueprintPure, Category = "ACF | Getters")
@@ -84,6 +84,11 @@ void UACFEquipmentComponent::OnComponentLoaded_Implementation()
     RefreshTotalWeight();
 }
 
+void UACFEquipmentComponent::NativeOnComponentLoaded()
+{
+    OnComponentLoaded_Implementation();
+}
+
 void UACFEquipmentComponent::AddItemToInventory_Implementation(const FBaseItem& ItemToAdd, bool bAutoEquip)
 {
     Internal_AddItem(ItemToAdd, bAutoEquip);
@@ -36,6 +36,16 @@ void UACFStorageComponent::OnComponentSaved_Implementation()
 {
 }
 
+void UACFStorageComponent::NativeOnComponentLoaded()
+{
+    OnComponentLoaded_Implementation();
+}
+
+void UACFStorageComponent::NativeOnComponentSaved()
+{
+    OnComponentSaved_Implementation();
+}
+
 void UACFStorageComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -7,6 +7,7 @@
 #include <GameplayTagContainer.h>
 
 #include "ACFItemTypes.h"
+#include "ALSSavableComponentInterface.h"
 #include "Components/ActorComponent.h"
 #include "CoreMinimal.h"
 #include "Items/ACFItem.h"
@@ -207,7 +208,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemAdded, const FBaseItem&, item
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemRemoved, const FBaseItem&, item);
 
 UCLASS(Blueprintable, ClassGroup = (ACF), meta = (BlueprintSpawnableComponent))
-class INVENTORYSYSTEM_API UACFEquipmentComponent : public UActorComponent {
+class INVENTORYSYSTEM_API UACFEquipmentComponent : public UActorComponent, public IALSSavableComponentInterface {
     GENERATED_BODY()
 
 public:
@@ -612,6 +613,9 @@ protected:
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = ACF)
     void OnComponentLoaded();
 
+    /*IALSSavableComponentInterface*/
+    virtual void NativeOnComponentLoaded() override;
+
     virtual void BeginDestroy() override;
 
 
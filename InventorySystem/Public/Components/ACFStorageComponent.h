@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ACFItemTypes.h"
+#include "ALSSavableComponentInterface.h"
 #include "Components/ACFCurrencyComponent.h"
 #include "Components/ActorComponent.h"
 #include "CoreMinimal.h"
@@ -14,7 +15,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemsChanged, const TArray<FBaseI
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStorageEmpty);
 
 UCLASS(ClassGroup = (ACF), Blueprintable, meta = (BlueprintSpawnableComponent))
-class INVENTORYSYSTEM_API UACFStorageComponent : public UACFCurrencyComponent {
+class INVENTORYSYSTEM_API UACFStorageComponent : public UACFCurrencyComponent, public IALSSavableComponentInterface {
     GENERATED_BODY()
 
 public:
@@ -34,6 +35,11 @@ protected:
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = ACF)
     void OnComponentSaved();
 
+    /*IALSSavableComponentInterface*/
+    virtual void NativeOnComponentLoaded() override;
+
+    virtual void NativeOnComponentSaved() override;
+
 public:
     UFUNCTION(Server, Reliable, BlueprintCallable, Category = ACF)
     void RemoveItems(const TArray<FBaseItem>& inItems);